@@ -0,0 +1,90 @@
+#include "AsyncPlanner.hpp"
+
+#include <utility>
+
+AsyncPlanner::AsyncPlanner(Planner& planner)
+    : planner(planner), worker([this] { workerLoop(); }) {}
+
+AsyncPlanner::~AsyncPlanner() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void AsyncPlanner::submit(const Board& board, const Shape& active, int targetGridX, int targetGridY,
+                          bool rotateFirst) {
+    const uint64_t serial = ++lastSerial;
+    if (targetGridX != lastTargetX || targetGridY != lastTargetY) {
+        cancelBefore.store(serial, std::memory_order_relaxed);
+        lastTargetX = targetGridX;
+        lastTargetY = targetGridY;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending.board) *pending.board = board;
+        else               pending.board.emplace(board);
+        pending.active      = active;
+        pending.targetGridX = targetGridX;
+        pending.targetGridY = targetGridY;
+        pending.rotateFirst = rotateFirst;
+        pending.serial      = serial;
+        hasPending          = true;
+    }
+    wake.notify_one();
+}
+
+void AsyncPlanner::cancel() noexcept {
+    cancelBefore.store(++lastSerial, std::memory_order_relaxed);
+    lastTargetX = lastTargetY = -1;
+}
+
+std::optional<AsyncPlanner::Result> AsyncPlanner::poll() {
+    std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+    if (!lock.owns_lock() || !fresh) return std::nullopt;
+    fresh = false;
+
+    const Slot& slot = slots[front];
+    if (isStale(slot.serial)) return std::nullopt;
+    return slot.result;
+}
+
+void AsyncPlanner::workerLoop() {
+    Request working;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || hasPending; });
+            if (stopping) return;
+            std::swap(working, pending);
+            hasPending = false;
+        }
+        if (isStale(working.serial)) continue;
+
+        // Only this thread writes `front`, so reading it unlocked is safe.
+        Slot& slot   = slots[1 - front];
+        Result& out  = slot.result;
+        slot.serial  = working.serial;
+        out.active   = working.active;
+        out.rotated  = working.rotateFirst;
+        out.targetGridX = working.targetGridX;
+        out.targetGridY = working.targetGridY;
+
+        const Board& board = *working.board;
+        if (working.rotateFirst) {
+            planner.autoRotateCurrentShape(board, out.active, working.targetGridX, working.targetGridY);
+            if (isStale(working.serial)) continue;
+        }
+        out.lock = planner.planMousePlacement(board, out.active, working.targetGridX, working.targetGridY);
+        out.coversTarget = out.lock.has_value()
+                        && Planner::shapeCoversCell(*out.lock, working.targetGridX, working.targetGridY);
+        if (isStale(working.serial)) continue;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        front = 1 - front;
+        fresh = true;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "Board.hpp"
+#include "Planner.hpp"
+#include "Shape.hpp"
+
+// Runs mouse-placement planning on a background thread. The caller submits
+// board snapshots and polls for results; neither call blocks on a search.
+// Only the newest request is kept, and moving the target to another cell
+// cancels everything submitted before it. The planner belongs to the
+// worker once the first request is submitted.
+class AsyncPlanner {
+public:
+    struct Result {
+        Shape                active{Shape::Type::O, 0, 0}; // start piece, rotated when requested
+        std::optional<Shape> lock;
+        bool                 coversTarget = false;
+        bool                 rotated      = false;
+        int                  targetGridX  = -1;
+        int                  targetGridY  = -1;
+    };
+
+    explicit AsyncPlanner(Planner& planner);
+    ~AsyncPlanner();
+
+    AsyncPlanner(const AsyncPlanner&) = delete;
+    AsyncPlanner& operator=(const AsyncPlanner&) = delete;
+
+    // `rotateFirst` runs autoRotateCurrentShape on the piece before planning.
+    void submit(const Board& board, const Shape& active, int targetGridX, int targetGridY, bool rotateFirst);
+    // Drops pending and in-flight work, e.g. once the board has changed.
+    void cancel() noexcept;
+    // Takes the newest finished result, if any arrived since the last call.
+    std::optional<Result> poll();
+
+private:
+    struct Request {
+        std::optional<Board> board;
+        Shape    active{Shape::Type::O, 0, 0};
+        int      targetGridX = -1;
+        int      targetGridY = -1;
+        bool     rotateFirst = false;
+        uint64_t serial      = 0;
+    };
+
+    struct Slot {
+        Result   result;
+        uint64_t serial = 0;
+    };
+
+    Planner& planner;
+
+    std::mutex              mutex;
+    std::condition_variable wake;
+    Request                 pending;
+    bool                    hasPending = false;
+    bool                    stopping   = false;
+
+    // Double buffer: the worker fills slots[1 - front], then flips `front`.
+    Slot slots[2];
+    int  front = 0;
+    bool fresh = false;
+
+    std::atomic<uint64_t> cancelBefore{0};
+    uint64_t              lastSerial  = 0;
+    int                   lastTargetX = -1;
+    int                   lastTargetY = -1;
+
+    std::thread worker;
+
+    bool isStale(uint64_t serial) const noexcept { return serial < cancelBefore.load(std::memory_order_relaxed); }
+    void workerLoop();
+};
@@ -1,79 +1,40 @@
 #include "Board.hpp"
 
+#include <algorithm>
+#include <limits>
 
-Board::Board(int rows, int cols, int cellSize, SDL_Color backgroundColor, uint32_t seed)
-    : rows(rows), cols(cols), cellSize(cellSize), backgroundColor(backgroundColor),
-      grid(rows, std::vector<int>(cols, 0)),
-      colorGrid(rows, std::vector<SDL_Color>(cols, {0, 0, 0, 0})),
-      rng(seed) {
-        hardDropAnims.reserve(64);
-        bubbleParticles.reserve(512);
-        landingAnims.reserve(128);
-      }
-
-Board::~Board() {
-    if (whiteCellTexture) { SDL_DestroyTexture(whiteCellTexture); whiteCellTexture = nullptr; }
-    clearTileTextures();
-    if (gridBgTex) { SDL_DestroyTexture(gridBgTex); gridBgTex = nullptr; }
+namespace {
+constexpr uint64_t splitmix64(uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
 }
-
-void Board::initializeTexture(SDL_Renderer* renderer) {
-    if (cellSize <= 2) return;
-    if (whiteCellTexture) {
-        SDL_DestroyTexture(whiteCellTexture);
-        whiteCellTexture = nullptr;
-    }
-
-    whiteCellTexture = SDL_CreateTexture(renderer,
-                                         SDL_PIXELFORMAT_RGBA8888,
-                                         SDL_TEXTUREACCESS_TARGET,
-                                         cellSize - 2, cellSize - 2);
-
-    if (!whiteCellTexture) {
-        SDL_Log("Failed to create whiteCellTexture: %s", SDL_GetError());
-        return;
-    }
-
-    if (SDL_SetTextureBlendMode(whiteCellTexture, SDL_BLENDMODE_BLEND) != 0) {
-        SDL_Log("Failed to set blend mode for whiteCellTexture: %s", SDL_GetError());
-        SDL_DestroyTexture(whiteCellTexture);
-        whiteCellTexture = nullptr;
-        return;
-    }
-
-    if (SDL_SetRenderTarget(renderer, whiteCellTexture) != 0) {
-        SDL_Log("Failed to set render target: %s", SDL_GetError());
-        SDL_DestroyTexture(whiteCellTexture);
-        whiteCellTexture = nullptr;
-        return;
-    }
-
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-    SDL_RenderClear(renderer);
-    draw_smooth_rounded_rect(renderer, 0, 0, cellSize - 2, cellSize - 2, 2,
-                             {255, 255, 255, 255}, true);
-
-    SDL_SetRenderTarget(renderer, nullptr);
 }
 
-bool Board::isOccupied(const std::vector<std::pair<int, int>>& coords, int dx, int dy) const noexcept {
-    for (const auto& coord : coords) {
-        int x = coord.first + dx;
-        int y = coord.second + dy;
-
-        if (x < 0 || x >= cols || y >= rows) {
-            return true;
-        }
+Board::Board(int rows, int cols)
+    : rows(rows), cols(cols),
+      field(rows, cols) {}
 
-        if (y < 0) {
-            continue;
-        }
+bool Board::isOccupied(const Shape& shape, int dx, int dy) const noexcept {
+    return field.isOccupied(shape, dx, dy);
+}
 
-        if (grid[y][x] != 0) {
-            return true;
+int Board::dropDistance(const Shape& shape) const noexcept {
+    // Above the stack every column is empty down to its top, so the lowest
+    // gap between a cell and its column top decides. A piece tucked under
+    // an overhang has no such guarantee and is walked down instead.
+    int distance = std::numeric_limits<int>::max();
+    for (const auto& [x, y] : shape.getCoords()) {
+        const int top = (x >= 0 && x < cols) ? field.getColumnTop(x) : -1;
+        if (y >= top) {
+            int d = 0;
+            while (!field.isOccupied(shape, 0, d + 1)) ++d;
+            return d;
         }
+        distance = std::min(distance, top - 1 - y);
     }
-    return false;
+    return distance;
 }
 
 void Board::placeShape(const Shape& shape) {
@@ -82,148 +43,25 @@ void Board::placeShape(const Shape& shape) {
         int y = coord.second;
         
         if (y >= 0 && y < rows && x >= 0 && x < cols) {
-            grid[y][x] = 1;
-            colorGrid[y][x] = shape.getColor();
-
-            landingAnims.push_back({x, y, SDL_GetTicks()});
-        }
-    }
-}
-
-Uint8 Board::landingAlpha(int x, int y, Uint32 now) const noexcept {
-    for (const auto& a : landingAnims) {
-        if (a.x == x && a.y == y) {
-            Uint32 t = now - a.startTime;
-
-            if (t < FADE_OUT_MS) {
-                float p = t / float(FADE_OUT_MS);
-                return Uint8(255 - p * 200);
-            } else if (t < FADE_OUT_MS + FADE_IN_MS) {
-                float p = (t - FADE_OUT_MS) / float(FADE_IN_MS);
-                return Uint8(55 + p * 200);
-            }
+            if (!field.isCellFilled(x, y)) zobrist ^= cellKey(x, y);
+            field.fillCell(x, y, shape.getColorIndex());
         }
     }
-    return 255;
 }
 
-
-
 int Board::clearFullLines() {
     linesToClear.clear();
     for (int y = rows - 1; y >= 0; --y) {
-        if (std::all_of(grid[y].begin(), grid[y].end(), [](int cell) { return cell != 0; })) {
+        if (field.isRowFull(y)) {
             linesToClear.push_back(y);
         }
     }
     if (!linesToClear.empty()) {
         isClearingLines = true;
-        clearStartTime = SDL_GetTicks();
     }
     return linesToClear.size();
 }
 
-void Board::draw(SDL_Renderer* renderer, int offsetX, int offsetY, bool showPlacedBlocks) const {
-    const int boardWidth  = cols * cellSize;
-    const int boardHeight = rows * cellSize;
-    const int gridGap = 1;
-
-    auto isRowClearing = [this](int y) {
-        for (int r : linesToClear) if (r == y) return true;
-        return false;
-    };
-
-    if (gridBgTex == nullptr) {
-        const_cast<Board*>(this)->rebuildGridBackground(renderer);
-    }
-    if (gridBgTex) {
-        SDL_Rect dst{ offsetX, offsetY, boardWidth, boardHeight };
-        SDL_RenderCopy(renderer, gridBgTex, nullptr, &dst);
-    }
-
-    Uint32 now = SDL_GetTicks();
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-
-    for (int y = 0; y < rows; ++y) {
-        const bool isLineClearing = isClearingLines && isRowClearing(y);
-        for (int x = 0; x < cols; ++x) {
-            const bool isFullCell = (grid[y][x] != 0);
-            if (!showPlacedBlocks || !isFullCell) continue;
-
-            const int cellX = offsetX + x * cellSize + gridGap;
-            const int cellY = offsetY + y * cellSize + gridGap;
-            const int cellDrawSize = cellSize - 2 * gridGap;
-
-            if (isLineClearing) {
-                SDL_Color color = colorGrid[y][x];
-                Uint32 currentTime = SDL_GetTicks();
-                float elapsed = static_cast<float>(currentTime - clearStartTime);
-                float progress = std::min(elapsed / 500.0f, 1.0f);
-                Uint8 alpha = static_cast<Uint8>(255 * (1.0f - progress));
-                float rotation = 360.0f * progress;
-                SDL_Rect destRect = {cellX, cellY, cellDrawSize, cellDrawSize};
-
-                SDL_SetTextureColorMod(whiteCellTexture, color.r, color.g, color.b);
-                SDL_SetTextureAlphaMod(whiteCellTexture, alpha);
-                SDL_RenderCopyEx(renderer, whiteCellTexture, nullptr, &destRect, rotation, nullptr, SDL_FLIP_NONE);
-            } else {
-                SDL_Color base = colorGrid[y][x];
-                SDL_Rect dst{ cellX, cellY, cellDrawSize, cellDrawSize };
-
-                SDL_Texture* tex = getTileTexture(renderer, base);
-                if (tex) SDL_RenderCopy(renderer, tex, nullptr, &dst);
-                Uint8 a = landingAlpha(x, y, now);
-                if (a < 255) {
-                    Uint8 glow = static_cast<Uint8>((255 - a) * 0.9f);
-
-                    SDL_Rect dst{ cellX, cellY, cellDrawSize, cellDrawSize };
-
-                    SDL_SetTextureColorMod(whiteCellTexture, 255, 255, 255);
-                    SDL_SetTextureAlphaMod(whiteCellTexture, glow);
-
-                    SDL_SetTextureBlendMode(whiteCellTexture, SDL_BLENDMODE_ADD);
-                    SDL_RenderCopy(renderer, whiteCellTexture, nullptr, &dst);
-                    SDL_SetTextureBlendMode(whiteCellTexture, SDL_BLENDMODE_BLEND);
-                }
-            }
-        }
-    }
-
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
-    
-    for (const auto& anim : hardDropAnims) {
-        Uint32 elapsed = now - anim.startTime;
-        if (elapsed > HARD_DROP_ANIM_DURATION) continue;
-        float progress = elapsed / (float)HARD_DROP_ANIM_DURATION;
-        Uint8 baseAlpha = static_cast<Uint8>(180 * (1.0f - progress * progress));
-        int cellX = offsetX + anim.col * cellSize;
-        int span = std::max(1, anim.endRow - anim.startRow);
-
-        for (int row = anim.startRow; row < anim.endRow; ++row) {
-            float rowT = (row - anim.startRow) / float(span);
-            float falloff = rowT * rowT;
-            Uint8 rowAlpha = static_cast<Uint8>(baseAlpha * falloff);
-            int cellY = offsetY + row * cellSize;
-            SDL_Rect flashRect = { cellX + 1, cellY + 1, cellSize - 2, cellSize - 2 };
-            SDL_SetRenderDrawColor(renderer, 180, 180, 180, rowAlpha);
-            SDL_RenderFillRect(renderer, &flashRect);
-        }
-    }
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-    for (const auto& p : bubbleParticles) {
-        int px = offsetX + static_cast<int>(p.x * cellSize);
-        int py = offsetY + static_cast<int>(p.y * cellSize);
-        int radius = std::max(1, cellSize / 16);
-        SDL_Color col{255, 255, 255, p.alpha};
-        drawAACircle(renderer, px, py, radius, col);
-    }
-    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
-}
-
-
-
 int Board::getRows() const noexcept {
     return rows;
 }
@@ -232,12 +70,8 @@ int Board::getCols() const noexcept {
     return cols;
 }
 
-int Board::getCellSize() const noexcept {
-    return cellSize;
-}
-
-const std::vector<std::vector<int>>& Board::getGrid() const noexcept {
-    return grid;
+const Playfield& Board::getPlayfield() const noexcept {
+    return field;
 }
 
 const std::vector<int>& Board::getLinesToClear() const noexcept {
@@ -245,34 +79,11 @@ const std::vector<int>& Board::getLinesToClear() const noexcept {
 }
 
 int Board::countFullLines() const {
-    int fullLineCount = 0;
-    for (int y = 0; y < rows; ++y) {
-        bool isFull = std::all_of(grid[y].begin(), grid[y].end(),
-                                  [](int cell) { return cell != 0; });
-        if (isFull) {
-            fullLineCount++;
-        }
-    }
-    return fullLineCount;
+    return field.countFullLines();
 }
 
 int Board::countHoles() const {
-    int holes = 0;
-    
-    for (int x = 0; x < cols; ++x) {
-        bool foundBlockInColumn = false;
-        
-        for (int y = 0; y < rows; ++y) {
-            if (grid[y][x] != 0) {
-                foundBlockInColumn = true;
-            } else {
-                if (foundBlockInColumn) {
-                    holes++;
-                }
-            }
-        }
-    }
-    return holes;
+    return field.getTotalHoles();
 }
 
 std::pair<std::vector<std::pair<int, int>>, bool> Board::getSurfaceCoordsAndFlatStatus(int x) const {
@@ -282,21 +93,9 @@ std::pair<std::vector<std::pair<int, int>>, bool> Board::getSurfaceCoordsAndFlat
         return {surfaceCoords, false};
     }
 
-    int heightLeft = -1, heightMid = -1, heightRight = -1;
-
-    for (int y = 0; y < rows; ++y) {
-        if (heightLeft == -1 && grid[y][x - 1] != 0) heightLeft = y - 1;
-        if (heightMid == -1 && grid[y][x] != 0) heightMid = y - 1;
-        if (heightRight == -1 && grid[y][x + 1] != 0) heightRight = y - 1;
-    }
-
-    if (heightLeft == -1) heightLeft = rows - 1;
-    if (heightMid == -1) heightMid = rows - 1;
-    if (heightRight == -1) heightRight = rows - 1;
-
-    heightLeft = std::clamp(heightLeft, 0, rows - 1);
-    heightMid = std::clamp(heightMid, 0, rows - 1);
-    heightRight = std::clamp(heightRight, 0, rows - 1);
+    const int heightLeft  = std::clamp(field.getColumnTop(x - 1) - 1, 0, rows - 1);
+    const int heightMid   = std::clamp(field.getColumnTop(x) - 1, 0, rows - 1);
+    const int heightRight = std::clamp(field.getColumnTop(x + 1) - 1, 0, rows - 1);
 
     surfaceCoords.push_back({x - 1, heightLeft});
     surfaceCoords.push_back({x, heightMid});
@@ -309,236 +108,40 @@ std::pair<std::vector<std::pair<int, int>>, bool> Board::getSurfaceCoordsAndFlat
 
 
 void Board::clearBoard() {
-    for (int y = 0; y < rows; ++y) {
-        for (int x = 0; x < cols; ++x) {
-            grid[y][x] = 0;
-            colorGrid[y][x] = {0, 0, 0, 0};
-        }
-    }
+    field.clear();
+    zobrist = 0;
 }
 
 void Board::finalizeLineClear() {
     if (!isClearingLines) return;
 
-    std::vector<char> clear(rows, 0);
-    for (int y : linesToClear) clear[y] = 1;
-
-    int write = rows - 1;
-    for (int read = rows - 1; read >= 0; --read) {
-        if (!clear[read]) {
-            if (write != read) {
-                grid[write]      = std::move(grid[read]);
-                colorGrid[write] = std::move(colorGrid[read]);
-            }
-            --write;
-        }
-    }
-    for (; write >= 0; --write) {
-        grid[write].assign(cols, 0);
-        colorGrid[write].assign(cols, SDL_Color{0,0,0,0});
-    }
+    // Rows below the lowest cleared line keep their contents; everything
+    // from there up shifts, so rehash just that band.
+    const int band = linesToClear.empty() ? -1 : linesToClear.front();
+    for (int y = 0; y <= band; ++y) zobrist ^= rowKey(y, field.getRowMask(y));
+    field.removeLines(linesToClear);
+    for (int y = 0; y <= band; ++y) zobrist ^= rowKey(y, field.getRowMask(y));
 
     isClearingLines = false;
     linesToClear.clear();
-    clearStartTime = 0;
 }
 
 
-void Board::updateLandingAnimations() {
-    Uint32 now = SDL_GetTicks();
-    landingAnims.erase(
-        std::remove_if(landingAnims.begin(), landingAnims.end(),
-            [now](const LandingAnim& a) {
-                return now - a.startTime > (FADE_OUT_MS + FADE_IN_MS);
-            }),
-        landingAnims.end());
+uint64_t Board::cellKey(int x, int y) noexcept {
+    return splitmix64((uint64_t(uint32_t(y)) << 8) | uint32_t(x));
 }
 
-void Board::triggerHardDropAnim(const Shape& shape) {
-    Uint32 now = SDL_GetTicks();
-    std::unordered_map<int, int> topRows;
-    
-    for (const auto& coord : shape.getCoords()) {
-        int col = coord.first;
-        if (topRows.find(col) == topRows.end() || coord.second < topRows[col]) {
-            topRows[col] = coord.second;
-        }
-    }
-    
-    for (const auto& [col, row] : topRows) {
-        hardDropAnims.push_back({col, 0, row, now});
-
-        const int maxSpan = std::max(row, 1);
-        const int denom   = maxSpan * 100;
-
-        if (denom > 0) {
-            std::uniform_int_distribution<int> fyInt(0, denom - 1);
-            std::uniform_int_distribution<int> vyInt(0, 29);
-            for (int i = 0; i < 5; ++i) {
-                float fx = col + 0.5f;
-                float fy = fyInt(rng) / 100.0f;
-                float vx = 0.0f;
-                float vy = -0.05f - (vyInt(rng) / 300.0f);
-                bubbleParticles.push_back({fx, fy, vx, vy, 255, now});
-            }
-        }
-    }
+uint64_t Board::pieceKey(Shape::Type type, int rotation) noexcept {
+    return splitmix64(0xFFFF'0000ull | (uint64_t(type) << 2) | uint64_t(rotation & 3));
 }
 
-void Board::updateHardDropAnimations() {
-    Uint32 now = SDL_GetTicks();
-    auto it = hardDropAnims.begin();
-    while (it != hardDropAnims.end()) {
-        if (now - it->startTime > HARD_DROP_ANIM_DURATION) {
-            it = hardDropAnims.erase(it);
-        } else {
-            ++it;
-        }
-    }
-}
-
-void Board::updateBubbleParticles() {
-    Uint32 now = SDL_GetTicks();
-    bubbleParticles.erase(
-        std::remove_if(bubbleParticles.begin(), bubbleParticles.end(),
-            [now](const BubbleParticle& p) {
-                return now - p.startTime > 600;
-            }),
-        bubbleParticles.end()
-    );
-
-    for (auto& p : bubbleParticles) {
-        p.x += p.vx;
-        p.y += p.vy;
-        float lifeRatio = (now - p.startTime) / 600.0f;
-        p.alpha = Uint8(255 * (1.0f - lifeRatio * lifeRatio));
-    }
-}
-
-void Board::updateAnimations() {
-    updateLandingAnimations();
-    updateHardDropAnimations();
-    updateBubbleParticles();
+uint64_t Board::rowKey(int y, Playfield::RowMask mask) const noexcept {
+    uint64_t key = 0;
+    for (; mask; mask &= mask - 1) key ^= cellKey(__builtin_ctz(mask), y);
+    return key;
 }
 
 bool Board::isCellReachable(int x, int y) const noexcept {
-    if (y < 0) return true;
-    
-    for (int i = y - 1; i >= 0; i--) {
-        if (grid[i][x] != 0) {
-            return false;
-        }
-    }
-    return true;
-}
-
-void Board::rebuildGridBackground(SDL_Renderer* renderer) {
-    if (gridBgTex) {
-        SDL_DestroyTexture(gridBgTex);
-        gridBgTex = nullptr;
-    }
-
-    const int boardWidth  = cols * cellSize;
-    const int boardHeight = rows * cellSize;
-    const int gridGap = 1;
-
-    gridBgTex = SDL_CreateTexture(
-        renderer,
-        SDL_PIXELFORMAT_RGBA8888,
-        SDL_TEXTUREACCESS_TARGET,
-        boardWidth,
-        boardHeight
-    );
-    if (!gridBgTex) {
-        SDL_Log("Failed to create gridBgTex: %s", SDL_GetError());
-        return;
-    }
-
-    SDL_SetTextureBlendMode(gridBgTex, SDL_BLENDMODE_BLEND);
-
-    SDL_SetRenderTarget(renderer, gridBgTex);
-
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
-    SDL_RenderClear(renderer);
-
-    draw_smooth_rounded_rect(
-        renderer,
-        0, 0,
-        boardWidth, boardHeight,
-        5,
-        SDL_Color{50, 50, 50, 255},
-        true
-    );
-    for (int y = 0; y < rows; ++y) {
-        for (int x = 0; x < cols; ++x) {
-            const int cellX = x * cellSize + gridGap;
-            const int cellY = y * cellSize + gridGap;
-            const int cellDrawSize = cellSize - 2 * gridGap;
-            draw_smooth_rounded_rect(
-                renderer,
-                cellX, cellY,
-                cellDrawSize, cellDrawSize,
-                2,
-                SDL_Color{0, 0, 0, 255},
-                true
-            );
-        }
-    }
-
-    SDL_SetRenderTarget(renderer, nullptr);
+    return field.isColumnClearAbove(x, y);
 }
 
-void Board::clearTileTextures() {
-    for (auto& kv : tileTexByColor) {
-        if (kv.second) SDL_DestroyTexture(kv.second);
-    }
-    tileTexByColor.clear();
-}
-
-SDL_Texture* Board::getTileTexture(SDL_Renderer* r, SDL_Color base) const {
-    uint32_t key = packColor(base);
-    if (auto it = tileTexByColor.find(key); it != tileTexByColor.end())
-        return it->second;
-
-    const int gridGap = 1;
-    const int w = cellSize - 2 * gridGap;
-    const int h = cellSize - 2 * gridGap;
-    if (w <= 0 || h <= 0) return nullptr;
-
-    SDL_Texture* tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888,
-                                         SDL_TEXTUREACCESS_TARGET, w, h);
-    if (!tex) return nullptr;
-    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
-
-    SDL_SetRenderTarget(r, tex);
-    SDL_SetRenderDrawColor(r, 0,0,0,0);
-    SDL_RenderClear(r);
-
-    SDL_Color border = darker(base, 0.55f);
-    draw_tetris_cell(r, 0, 0, w, h, 6, 1, 2,
-                     base, border);
-    draw_smooth_parabolic_highlight_arc(r, 0, 0, w, h, 1, 2);
-
-    SDL_SetRenderTarget(r, nullptr);
-
-    tileTexByColor.emplace(key, tex);
-    return tex;
-}
-
-void Board::prewarm(SDL_Renderer* r) {
-    initializeTexture(r);
-    rebuildGridBackground(r);
-
-    const SDL_Color pieceColors[] = {
-        {0,255,255,255},
-        {255,255,0,255},
-        {128,0,128,255},
-        {0,255,0,255},
-        {255,0,0,255},
-        {0,0,255,255},
-        {255,165,0,255}
-    };
-    for (auto c : pieceColors) {
-        (void)getTileTexture(r, c);
-    }
-}
\ No newline at end of file
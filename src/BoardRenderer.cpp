@@ -0,0 +1,483 @@
+#include "BoardRenderer.hpp"
+#include "ShapeRenderer.hpp"
+
+#include <algorithm>
+
+namespace {
+bool isRowClearing(const Board& board, int y) {
+    if (!board.isClearingLines) return false;
+    for (int r : board.getLinesToClear()) if (r == y) return true;
+    return false;
+}
+}
+
+BoardRenderer::BoardRenderer(int rows, int cols, int cellSize, SDL_Color backgroundColor, uint32_t seed)
+    : rows(rows), cols(cols), cellSize(cellSize), backgroundColor(backgroundColor),
+      rng(seed) {
+        hardDropAnims.reserve(64);
+        bubbleParticles.reserve(512);
+        landingAnims.reserve(128);
+      }
+
+BoardRenderer::~BoardRenderer() {
+    destroyAtlas();
+    if (stackTex) { SDL_DestroyTexture(stackTex); stackTex = nullptr; }
+    if (gridBgTex) { SDL_DestroyTexture(gridBgTex); gridBgTex = nullptr; }
+}
+
+void BoardRenderer::initializeTexture(SDL_Renderer* renderer) {
+    if (cellSize <= 2) return;
+    destroyAtlas();
+    invalidateStackLayer();
+
+    const int tile     = cellSize - 2;
+    const int slotSize = tile + 2 * AtlasGutter;
+    atlasWidth  = AtlasSlots * slotSize;
+    atlasHeight = slotSize;
+
+    tileAtlas = SDL_CreateTexture(renderer,
+                                  SDL_PIXELFORMAT_RGBA8888,
+                                  SDL_TEXTUREACCESS_TARGET,
+                                  atlasWidth, atlasHeight);
+
+    if (!tileAtlas) {
+        SDL_Log("Failed to create tile atlas: %s", SDL_GetError());
+        return;
+    }
+
+    if (SDL_SetTextureBlendMode(tileAtlas, SDL_BLENDMODE_BLEND) != 0) {
+        SDL_Log("Failed to set blend mode for tile atlas: %s", SDL_GetError());
+        destroyAtlas();
+        return;
+    }
+
+    if (SDL_SetRenderTarget(renderer, tileAtlas) != 0) {
+        SDL_Log("Failed to set render target: %s", SDL_GetError());
+        destroyAtlas();
+        return;
+    }
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    for (int slot = 0; slot < AtlasSlots; ++slot) {
+        drawAtlasSlot(renderer, slot, slot * slotSize + AtlasGutter, AtlasGutter, tile);
+    }
+
+    SDL_SetRenderTarget(renderer, nullptr);
+}
+
+void BoardRenderer::triggerLandingAnim(const Shape& shape) {
+    const Uint32 now = SDL_GetTicks();
+    for (const auto& coord : shape.getCoords()) {
+        int x = coord.first;
+        int y = coord.second;
+
+        if (y >= 0 && y < rows && x >= 0 && x < cols) {
+            landingAnims.push_back({x, y, now});
+        }
+    }
+}
+
+Uint8 BoardRenderer::landingAlpha(int x, int y, Uint32 now) const noexcept {
+    for (const auto& a : landingAnims) {
+        if (a.x == x && a.y == y) {
+            Uint32 t = now - a.startTime;
+
+            if (t < FADE_OUT_MS) {
+                float p = t / float(FADE_OUT_MS);
+                return Uint8(255 - p * 200);
+            } else if (t < FADE_OUT_MS + FADE_IN_MS) {
+                float p = (t - FADE_OUT_MS) / float(FADE_IN_MS);
+                return Uint8(55 + p * 200);
+            }
+        }
+    }
+    return 255;
+}
+
+void BoardRenderer::draw(SDL_Renderer* renderer, const Board& board, int offsetX, int offsetY,
+                         bool showPlacedBlocks, float clearProgress) const {
+    const Playfield& field = board.getPlayfield();
+    const int boardWidth  = cols * cellSize;
+    const int boardHeight = rows * cellSize;
+    const int gridGap = 1;
+
+    if (gridBgTex == nullptr) {
+        const_cast<BoardRenderer*>(this)->rebuildGridBackground(renderer);
+    }
+    if (gridBgTex) {
+        SDL_Rect dst{ offsetX, offsetY, boardWidth, boardHeight };
+        SDL_RenderCopy(renderer, gridBgTex, nullptr, &dst);
+    }
+
+    Uint32 now = SDL_GetTicks();
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    if (!showPlacedBlocks) {
+        drawEffects(renderer, offsetX, offsetY, now);
+        return;
+    }
+
+    updateStackLayer(renderer, board);
+    if (stackTex) {
+        SDL_Rect dst{ offsetX, offsetY, boardWidth, boardHeight };
+        SDL_RenderCopy(renderer, stackTex, nullptr, &dst);
+    }
+
+    tileVerts.clear();
+    tileIndices.clear();
+    glowVerts.clear();
+    glowIndices.clear();
+
+    const int cellDrawSize = cellSize - 2 * gridGap;
+    if (board.isClearingLines) {
+        const float progress = std::min(clearProgress, 1.0f);
+        const float rotation = 360.0f * progress;
+        for (int y : board.getLinesToClear()) {
+            if (y < 0 || y >= rows) continue;
+            for (int x = 0; x < cols; ++x) {
+                if (!field.isCellFilled(x, y)) continue;
+                SDL_Color color = ShapeRenderer::paletteColor(field.getColorIndex(x, y));
+                color.a = static_cast<Uint8>(255 * (1.0f - progress));
+                pushQuad(tileVerts, tileIndices, WhiteSlot, offsetX + x * cellSize + gridGap,
+                         offsetY + y * cellSize + gridGap, cellDrawSize, color, rotation);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < landingAnims.size(); ++i) {
+        const LandingAnim& anim = landingAnims[i];
+        if (!field.isCellFilled(anim.x, anim.y) || isRowClearing(board, anim.y)) continue;
+        // landingAlpha() goes by the first animation on a cell; skip the rest.
+        bool seen = false;
+        for (size_t j = 0; j < i && !seen; ++j) seen = landingAnims[j].x == anim.x && landingAnims[j].y == anim.y;
+        if (seen) continue;
+
+        Uint8 a = landingAlpha(anim.x, anim.y, now);
+        if (a < 255) {
+            Uint8 glow = static_cast<Uint8>((255 - a) * 0.9f);
+            pushQuad(glowVerts, glowIndices, WhiteSlot, offsetX + anim.x * cellSize + gridGap,
+                     offsetY + anim.y * cellSize + gridGap, cellDrawSize, {255, 255, 255, glow});
+        }
+    }
+
+    // Spinning rows, then the additive landing glow.
+    if (tileAtlas && !tileIndices.empty()) {
+        SDL_RenderGeometry(renderer, tileAtlas, tileVerts.data(), (int)tileVerts.size(),
+                           tileIndices.data(), (int)tileIndices.size());
+    }
+    if (tileAtlas && !glowIndices.empty()) {
+        SDL_SetTextureBlendMode(tileAtlas, SDL_BLENDMODE_ADD);
+        SDL_RenderGeometry(renderer, tileAtlas, glowVerts.data(), (int)glowVerts.size(),
+                           glowIndices.data(), (int)glowIndices.size());
+        SDL_SetTextureBlendMode(tileAtlas, SDL_BLENDMODE_BLEND);
+    }
+
+    drawEffects(renderer, offsetX, offsetY, now);
+}
+
+void BoardRenderer::drawEffects(SDL_Renderer* renderer, int offsetX, int offsetY, Uint32 now) const {
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
+    
+    for (const auto& anim : hardDropAnims) {
+        Uint32 elapsed = now - anim.startTime;
+        if (elapsed > HARD_DROP_ANIM_DURATION) continue;
+        float progress = elapsed / (float)HARD_DROP_ANIM_DURATION;
+        Uint8 baseAlpha = static_cast<Uint8>(180 * (1.0f - progress * progress));
+        int cellX = offsetX + anim.col * cellSize;
+        int span = std::max(1, anim.endRow - anim.startRow);
+
+        for (int row = anim.startRow; row < anim.endRow; ++row) {
+            float rowT = (row - anim.startRow) / float(span);
+            float falloff = rowT * rowT;
+            Uint8 rowAlpha = static_cast<Uint8>(baseAlpha * falloff);
+            int cellY = offsetY + row * cellSize;
+            SDL_Rect flashRect = { cellX + 1, cellY + 1, cellSize - 2, cellSize - 2 };
+            SDL_SetRenderDrawColor(renderer, 180, 180, 180, rowAlpha);
+            SDL_RenderFillRect(renderer, &flashRect);
+        }
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    for (const auto& p : bubbleParticles) {
+        int px = offsetX + static_cast<int>(p.x * cellSize);
+        int py = offsetY + static_cast<int>(p.y * cellSize);
+        int radius = std::max(1, cellSize / 16);
+        SDL_Color col{255, 255, 255, p.alpha};
+        drawAACircle(renderer, px, py, radius, col);
+    }
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+
+
+void BoardRenderer::updateLandingAnimations() {
+    Uint32 now = SDL_GetTicks();
+    landingAnims.erase(
+        std::remove_if(landingAnims.begin(), landingAnims.end(),
+            [now](const LandingAnim& a) {
+                return now - a.startTime > (FADE_OUT_MS + FADE_IN_MS);
+            }),
+        landingAnims.end());
+}
+
+void BoardRenderer::triggerHardDropAnim(const Shape& shape) {
+    Uint32 now = SDL_GetTicks();
+    std::unordered_map<int, int> topRows;
+    
+    for (const auto& coord : shape.getCoords()) {
+        int col = coord.first;
+        if (topRows.find(col) == topRows.end() || coord.second < topRows[col]) {
+            topRows[col] = coord.second;
+        }
+    }
+    
+    for (const auto& [col, row] : topRows) {
+        hardDropAnims.push_back({col, 0, row, now});
+
+        const int maxSpan = std::max(row, 1);
+        const int denom   = maxSpan * 100;
+
+        if (denom > 0) {
+            std::uniform_int_distribution<int> fyInt(0, denom - 1);
+            std::uniform_int_distribution<int> vyInt(0, 29);
+            for (int i = 0; i < 5; ++i) {
+                float fx = col + 0.5f;
+                float fy = fyInt(rng) / 100.0f;
+                float vx = 0.0f;
+                float vy = -0.05f - (vyInt(rng) / 300.0f);
+                bubbleParticles.push_back({fx, fy, vx, vy, 255, now});
+            }
+        }
+    }
+}
+
+void BoardRenderer::updateHardDropAnimations() {
+    Uint32 now = SDL_GetTicks();
+    auto it = hardDropAnims.begin();
+    while (it != hardDropAnims.end()) {
+        if (now - it->startTime > HARD_DROP_ANIM_DURATION) {
+            it = hardDropAnims.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void BoardRenderer::updateBubbleParticles() {
+    Uint32 now = SDL_GetTicks();
+    bubbleParticles.erase(
+        std::remove_if(bubbleParticles.begin(), bubbleParticles.end(),
+            [now](const BubbleParticle& p) {
+                return now - p.startTime > 600;
+            }),
+        bubbleParticles.end()
+    );
+
+    for (auto& p : bubbleParticles) {
+        p.x += p.vx;
+        p.y += p.vy;
+        float lifeRatio = (now - p.startTime) / 600.0f;
+        p.alpha = Uint8(255 * (1.0f - lifeRatio * lifeRatio));
+    }
+}
+
+void BoardRenderer::updateAnimations() {
+    updateLandingAnimations();
+    updateHardDropAnimations();
+    updateBubbleParticles();
+}
+
+void BoardRenderer::rebuildGridBackground(SDL_Renderer* renderer) {
+    if (gridBgTex) {
+        SDL_DestroyTexture(gridBgTex);
+        gridBgTex = nullptr;
+    }
+
+    const int boardWidth  = cols * cellSize;
+    const int boardHeight = rows * cellSize;
+    const int gridGap = 1;
+
+    gridBgTex = SDL_CreateTexture(
+        renderer,
+        SDL_PIXELFORMAT_RGBA8888,
+        SDL_TEXTUREACCESS_TARGET,
+        boardWidth,
+        boardHeight
+    );
+    if (!gridBgTex) {
+        SDL_Log("Failed to create gridBgTex: %s", SDL_GetError());
+        return;
+    }
+
+    SDL_SetTextureBlendMode(gridBgTex, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderTarget(renderer, gridBgTex);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    draw_smooth_rounded_rect(
+        renderer,
+        0, 0,
+        boardWidth, boardHeight,
+        5,
+        SDL_Color{50, 50, 50, 255},
+        true
+    );
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; ++x) {
+            const int cellX = x * cellSize + gridGap;
+            const int cellY = y * cellSize + gridGap;
+            const int cellDrawSize = cellSize - 2 * gridGap;
+            draw_smooth_rounded_rect(
+                renderer,
+                cellX, cellY,
+                cellDrawSize, cellDrawSize,
+                2,
+                SDL_Color{0, 0, 0, 255},
+                true
+            );
+        }
+    }
+
+    SDL_SetRenderTarget(renderer, nullptr);
+}
+
+void BoardRenderer::updateStackLayer(SDL_Renderer* r, const Board& board) const {
+    if (!tileAtlas) return;
+
+    const Playfield& field = board.getPlayfield();
+    const int boardWidth  = cols * cellSize;
+    const int boardHeight = rows * cellSize;
+    const int gridGap = 1;
+
+    if (!stackTex) {
+        stackTex = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                     boardWidth, boardHeight);
+        if (!stackTex) {
+            SDL_Log("Failed to create stack layer: %s", SDL_GetError());
+            return;
+        }
+        SDL_SetTextureBlendMode(stackTex, SDL_BLENDMODE_BLEND);
+        stackValid = false;
+    }
+    if (!stackValid) {
+        // No palette index matches, so every row counts as changed.
+        stackCells.assign(size_t(rows) * cols, 0xFF);
+        stackValid = true;
+    }
+
+    tileVerts.clear();
+    tileIndices.clear();
+    rowCells.resize(cols);
+    SDL_Texture* previousTarget = nullptr;
+    bool         targetSet      = false;
+
+    for (int y = 0; y < rows; ++y) {
+        const bool clearing = isRowClearing(board, y);
+        for (int x = 0; x < cols; ++x) {
+            rowCells[x] = (!clearing && field.isCellFilled(x, y)) ? field.getColorIndex(x, y) : 0;
+        }
+        uint8_t* drawn = &stackCells[size_t(y) * cols];
+        if (std::equal(rowCells.begin(), rowCells.end(), drawn)) continue;
+        std::copy(rowCells.begin(), rowCells.end(), drawn);
+
+        if (!targetSet) {
+            previousTarget = SDL_GetRenderTarget(r);
+            SDL_SetRenderTarget(r, stackTex);
+            SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+            SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+            targetSet = true;
+        }
+        SDL_Rect rowRect{ 0, y * cellSize, boardWidth, cellSize };
+        SDL_RenderFillRect(r, &rowRect);
+
+        for (int x = 0; x < cols; ++x) {
+            const uint8_t colorIndex = rowCells[x];
+            if (colorIndex == 0 || colorIndex >= AtlasSlots) continue;
+            pushQuad(tileVerts, tileIndices, colorIndex, x * cellSize + gridGap, y * cellSize + gridGap,
+                     cellSize - 2 * gridGap, {255, 255, 255, 255});
+        }
+    }
+
+    if (targetSet) {
+        if (!tileIndices.empty()) {
+            SDL_RenderGeometry(r, tileAtlas, tileVerts.data(), (int)tileVerts.size(),
+                               tileIndices.data(), (int)tileIndices.size());
+        }
+        SDL_SetRenderTarget(r, previousTarget);
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    }
+}
+
+void BoardRenderer::destroyAtlas() {
+    if (tileAtlas) SDL_DestroyTexture(tileAtlas);
+    tileAtlas   = nullptr;
+    atlasWidth  = 0;
+    atlasHeight = 0;
+}
+
+void BoardRenderer::drawAtlasSlot(SDL_Renderer* r, int slot, int x, int y, int size) const {
+    if (slot == WhiteSlot) {
+        draw_smooth_rounded_rect(r, x, y, size, size, 2, {255, 255, 255, 255}, true);
+        return;
+    }
+
+    const SDL_Color base = ShapeRenderer::paletteColor(static_cast<uint8_t>(slot));
+    SDL_Color border = darker(base, 0.55f);
+    draw_tetris_cell(r, x, y, size, size, 6, 1, 2,
+                     base, border);
+    draw_smooth_parabolic_highlight_arc(r, x, y, size, size, 1, 2);
+}
+
+void BoardRenderer::pushQuad(std::vector<SDL_Vertex>& verts, std::vector<int>& indices, int slot,
+                             float x, float y, float size, SDL_Color color, float degrees) const {
+    const int   tile     = cellSize - 2;
+    const int   slotSize = tile + 2 * AtlasGutter;
+    const float u0 = float(slot * slotSize + AtlasGutter) / atlasWidth;
+    const float u1 = u0 + float(tile) / atlasWidth;
+    const float v0 = float(AtlasGutter) / atlasHeight;
+    const float v1 = v0 + float(tile) / atlasHeight;
+
+    const float half = size * 0.5f;
+    const float cx = x + half;
+    const float cy = y + half;
+    float cosA = 1.0f, sinA = 0.0f;
+    if (degrees != 0.0f) {
+        const float rad = degrees * 3.14159265f / 180.0f;
+        cosA = std::cos(rad);
+        sinA = std::sin(rad);
+    }
+
+    // Corners clockwise from the top left; positive angles turn clockwise
+    // on screen, as SDL_RenderCopyEx does.
+    const float dx[4] = {-half,  half, half, -half};
+    const float dy[4] = {-half, -half, half,  half};
+    const float u[4]  = {u0, u1, u1, u0};
+    const float v[4]  = {v0, v0, v1, v1};
+
+    const int base = (int)verts.size();
+    for (int i = 0; i < 4; ++i) {
+        SDL_Vertex vert;
+        vert.position  = {cx + dx[i] * cosA - dy[i] * sinA, cy + dx[i] * sinA + dy[i] * cosA};
+        vert.color     = color;
+        vert.tex_coord = {u[i], v[i]};
+        verts.push_back(vert);
+    }
+    for (int i : {0, 1, 2, 0, 2, 3}) indices.push_back(base + i);
+}
+
+void BoardRenderer::prewarm(SDL_Renderer* r) {
+    initializeTexture(r);
+    rebuildGridBackground(r);
+
+    // Push one invisible batch so the geometry path is set up before play.
+    if (tileAtlas) {
+        tileVerts.clear();
+        tileIndices.clear();
+        pushQuad(tileVerts, tileIndices, WhiteSlot, 0.0f, 0.0f, 8.0f, {255, 255, 255, 0}, 45.0f);
+        SDL_RenderGeometry(r, tileAtlas, tileVerts.data(), (int)tileVerts.size(),
+                           tileIndices.data(), (int)tileIndices.size());
+    }
+}
\ No newline at end of file
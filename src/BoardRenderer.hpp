@@ -0,0 +1,109 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <random>
+#include <unordered_map>
+#include <cstdint>
+
+#include "Board.hpp"
+#include "DrawUtils.hpp"
+#include "Shape.hpp"
+
+class BoardRenderer {
+public:
+    static constexpr Uint32 FADE_OUT_MS             = 200;
+    static constexpr Uint32 FADE_IN_MS              = 100;
+    static constexpr Uint32 HARD_DROP_ANIM_DURATION = 300;
+
+    struct LandingAnim {
+        int    x;
+        int    y;
+        Uint32 startTime;
+    };
+
+    struct HardDropAnim {
+        int    col;
+        int    startRow;
+        int    endRow;
+        Uint32 startTime;
+    };
+
+    struct BubbleParticle {
+        float  x, y;
+        float  vx, vy;
+        Uint8  alpha;
+        Uint32 startTime;
+    };
+
+    BoardRenderer(int rows, int cols, int cellSize, SDL_Color backgroundColor, uint32_t seed = std::random_device{}());
+    ~BoardRenderer();
+
+    void initializeTexture(SDL_Renderer* renderer);
+    void draw(SDL_Renderer* renderer, const Board& board, int offsetX, int offsetY,
+              bool showPlacedBlocks, float clearProgress) const;
+
+    Uint8 landingAlpha(int x, int y, Uint32 now) const noexcept;
+
+    void updateAnimations();
+    void updateLandingAnimations();
+    void updateHardDropAnimations();
+    void updateBubbleParticles();
+    void triggerLandingAnim(const Shape& shape);
+    void triggerHardDropAnim(const Shape& shape);
+
+    void rebuildGridBackground(SDL_Renderer* renderer);
+    // Forces a full redraw of the cached stack layer on the next frame.
+    void invalidateStackLayer() noexcept { stackValid = false; }
+
+    void prewarm(SDL_Renderer* r);
+
+    int  getCellSize() const noexcept { return cellSize; }
+
+    std::vector<LandingAnim>     landingAnims;
+
+private:
+    int       rows;
+    int       cols;
+    int       cellSize;
+    SDL_Color backgroundColor;
+
+    std::vector<HardDropAnim>   hardDropAnims;
+    std::vector<BubbleParticle> bubbleParticles;
+
+    std::mt19937 rng;
+
+    mutable SDL_Texture* gridBgTex = nullptr;
+
+    // Every tile variant lives in one atlas so the stack goes out as a
+    // single geometry batch. Slot 0 holds the plain white cell used for
+    // tinted, rotated and glowing copies; slot i holds palette tile i.
+    static constexpr int AtlasSlots  = Shape::PaletteSize;
+    static constexpr int WhiteSlot   = 0;
+    static constexpr int AtlasGutter = 1;   // transparent border against filtering bleed
+
+    SDL_Texture* tileAtlas   = nullptr;
+    int          atlasWidth  = 0;
+    int          atlasHeight = 0;
+
+    // Settled cells are kept in a board-sized layer; each frame only the
+    // rows whose contents changed are redrawn into it. Rows that are being
+    // cleared are left out and drawn as spinning overlays instead.
+    mutable SDL_Texture*         stackTex   = nullptr;
+    mutable std::vector<uint8_t> stackCells;   // colour per cell as drawn in stackTex, 0 = empty
+    mutable std::vector<uint8_t> rowCells;
+    mutable bool                 stackValid = false;
+
+    void updateStackLayer(SDL_Renderer* r, const Board& board) const;
+    void drawEffects(SDL_Renderer* renderer, int offsetX, int offsetY, Uint32 now) const;
+
+    mutable std::vector<SDL_Vertex> tileVerts, glowVerts;
+    mutable std::vector<int>        tileIndices, glowIndices;
+
+    void destroyAtlas();
+    void drawAtlasSlot(SDL_Renderer* r, int slot, int x, int y, int size) const;
+    void pushQuad(std::vector<SDL_Vertex>& verts, std::vector<int>& indices, int slot,
+                  float x, float y, float size, SDL_Color color, float degrees = 0.0f) const;
+};
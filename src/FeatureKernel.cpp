@@ -0,0 +1,313 @@
+#include "FeatureKernel.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TETRIS_FEATURE_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+using RowMask = Playfield::RowMask;
+
+constexpr int FootprintCount = Shape::TypeCount * 4;
+
+// Per (type, rotation): bounding box offset from the origin, row bits with
+// bit 0 at the leftmost column, and the top cell and cell count of each
+// column. Laid out by field so the AVX2 path can gather from it.
+struct FootprintTable {
+    int32_t dx[FootprintCount], dy[FootprintCount];
+    int32_t width[FootprintCount], height[FootprintCount];
+    int32_t sumDx[FootprintCount];
+    int32_t rowBits[4][FootprintCount];
+    int32_t colTop[4][FootprintCount];
+    int32_t colCount[4][FootprintCount];
+};
+
+FootprintTable buildFootprints() {
+    FootprintTable t{};
+    for (int type = 0; type < Shape::TypeCount; ++type) {
+        for (int rot = 0; rot < 4; ++rot) {
+            const int i = type * 4 + rot;
+            Shape s(static_cast<Shape::Type>(type), 0, 0);
+            s.setRotation(rot);
+            s.setPosition(0, 0);
+            const Shape::Coords cells = s.getCoords();
+
+            int minX = INT_MAX, minY = INT_MAX, maxX = INT_MIN, maxY = INT_MIN;
+            for (const auto& c : cells) {
+                minX = std::min(minX, c.first);  maxX = std::max(maxX, c.first);
+                minY = std::min(minY, c.second); maxY = std::max(maxY, c.second);
+            }
+            t.dx[i]     = minX;
+            t.dy[i]     = minY;
+            t.width[i]  = maxX - minX + 1;
+            t.height[i] = maxY - minY + 1;
+            for (int j = 0; j < 4; ++j) t.colTop[j][i] = t.height[i];
+
+            for (const auto& c : cells) {
+                const int j = c.first - minX, k = c.second - minY;
+                t.sumDx[i]      += j;
+                t.rowBits[k][i] |= 1 << j;
+                t.colTop[j][i]   = std::min(t.colTop[j][i], k);
+                ++t.colCount[j][i];
+            }
+        }
+    }
+    return t;
+}
+
+const FootprintTable footprints = buildFootprints();
+
+int footprintOf(const Shape& s) noexcept {
+    return static_cast<int>(s.getType()) * 4 + s.getRotation();
+}
+
+bool fitsInside(const Playfield& field, int fp, int x0, int y0) noexcept {
+    return x0 >= 0 && y0 >= 0
+        && x0 + footprints.width[fp]  <= field.getCols()
+        && y0 + footprints.height[fp] <= field.getRows();
+}
+
+// Pieces poking out of the board (top-outs) take the per-cell route, where
+// every out-of-range neighbour counts as a contact.
+FeatureKernel::Features evaluateClipped(const Playfield& field, const Shape& locked) noexcept {
+    const Playfield::PlacementStats st = field.evaluatePlacement(locked);
+    const Shape::Coords cells = locked.getCoords();
+    const int rows = field.getRows(), cols = field.getCols();
+
+    FeatureKernel::Features f;
+    f.clearedLines    = st.clearedLines;
+    f.aggregateHeight = st.aggregateHeight;
+    f.holes           = st.holes;
+    f.bumpiness       = st.bumpiness;
+    f.minX = cols; f.minY = rows;
+    for (const auto& c : cells) {
+        f.minX  = std::min(f.minX, c.first);
+        f.maxX  = std::max(f.maxX, c.first);
+        f.minY  = std::min(f.minY, c.second);
+        f.sumX += c.first;
+    }
+
+    constexpr int dx[4] = { 0,  0, -1,  1 };
+    constexpr int dy[4] = { -1, 1,  0,  0 };
+    for (const auto& [x, y] : cells) {
+        for (int k = 0; k < 4; ++k) {
+            const int nx = x + dx[k], ny = y + dy[k];
+            if (nx < 0 || nx >= cols || ny < 0 || ny >= rows) { ++f.contacts; continue; }
+            if (std::find(cells.begin(), cells.end(), std::make_pair(nx, ny)) != cells.end()) continue;
+            if (field.isCellFilled(nx, ny)) ++f.contacts;
+        }
+    }
+    return f;
+}
+
+#ifdef TETRIS_FEATURE_AVX2
+__attribute__((target("avx2")))
+inline __m256i popcount32(__m256i v) noexcept {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i lo  = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, nibble));
+    const __m256i hi  = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    const __m256i per16 = _mm256_maddubs_epi16(_mm256_add_epi8(lo, hi), _mm256_set1_epi8(1));
+    return _mm256_madd_epi16(per16, _mm256_set1_epi16(1));
+}
+
+__attribute__((target("avx2")))
+inline __m256i gather(const int32_t* base, __m256i index) noexcept {
+    return _mm256_i32gather_epi32(reinterpret_cast<const int*>(base), index, 4);
+}
+
+// One lock per lane. Lanes that do not fit inside the board are computed
+// with bogus (but in-bounds) indices and then redone by evaluateClipped.
+__attribute__((target("avx2")))
+void evaluateAvx2(const Playfield& field, const Shape* locks, FeatureKernel::Features* out) noexcept {
+    constexpr int W = FeatureKernel::BatchWidth;
+    const int rows = field.getRows(), cols = field.getCols();
+
+    alignas(32) int32_t fpLane[W], x0Lane[W], y0Lane[W];
+    bool clipped[W];
+    for (int i = 0; i < W; ++i) {
+        const int fp = footprintOf(locks[i]);
+        fpLane[i]  = fp;
+        x0Lane[i]  = locks[i].getOriginX() + footprints.dx[fp];
+        y0Lane[i]  = locks[i].getOriginY() + footprints.dy[fp];
+        clipped[i] = !fitsInside(field, fp, x0Lane[i], y0Lane[i]);
+    }
+
+    const __m256i zero   = _mm256_setzero_si256();
+    const __m256i fp     = _mm256_load_si256(reinterpret_cast<const __m256i*>(fpLane));
+    const __m256i x0     = _mm256_load_si256(reinterpret_cast<const __m256i*>(x0Lane));
+    const __m256i y0     = _mm256_load_si256(reinterpret_cast<const __m256i*>(y0Lane));
+    const __m256i width  = gather(footprints.width, fp);
+    const __m256i height = gather(footprints.height, fp);
+
+    // Row bits: contacts from shifted-mask ANDs against the rows above,
+    // below and beside each piece row; new full rows from one compare.
+    const int32_t* padded   = reinterpret_cast<const int32_t*>(field.getPaddedRows());
+    const __m256i  full     = _mm256_set1_epi32(int32_t(field.getFullMask()));
+    const __m256i  rightBit = _mm256_set1_epi32(int32_t(RowMask(1u) << (cols - 1)));
+    const __m256i  lastRow  = _mm256_set1_epi32(rows - 1);
+    const __m256i  one      = _mm256_set1_epi32(1);
+
+    __m256i contacts = zero, cleared = zero;
+    for (int k = 0; k < 4; ++k) {
+        const __m256i active = _mm256_cmpgt_epi32(height, _mm256_set1_epi32(k));
+        const __m256i piece  = _mm256_sllv_epi32(gather(footprints.rowBits[k], fp), x0);
+        const __m256i y      = _mm256_min_epi32(_mm256_max_epi32(_mm256_add_epi32(y0, _mm256_set1_epi32(k)), zero), lastRow);
+        const __m256i above  = gather(padded, y);
+        const __m256i row    = gather(padded, _mm256_add_epi32(y, one));
+        const __m256i below  = gather(padded, _mm256_add_epi32(y, _mm256_set1_epi32(2)));
+        const __m256i left   = _mm256_or_si256(_mm256_slli_epi32(row, 1), one);
+        const __m256i right  = _mm256_or_si256(_mm256_srli_epi32(row, 1), rightBit);
+
+        contacts = _mm256_add_epi32(contacts, popcount32(_mm256_and_si256(piece, above)));
+        contacts = _mm256_add_epi32(contacts, popcount32(_mm256_and_si256(piece, below)));
+        contacts = _mm256_add_epi32(contacts, popcount32(_mm256_and_si256(piece, left)));
+        contacts = _mm256_add_epi32(contacts, popcount32(_mm256_and_si256(piece, right)));
+        cleared  = _mm256_sub_epi32(cleared, _mm256_and_si256(active, _mm256_cmpeq_epi32(_mm256_or_si256(row, piece), full)));
+    }
+
+    // Column stats for the piece columns and one neighbour on each side.
+    const int32_t* tops    = field.getColumnTops();
+    const __m256i  lastCol = _mm256_set1_epi32(cols - 1);
+    __m256i before[6], after[6];
+    for (int p = 0; p < 6; ++p) {
+        const __m256i c = _mm256_add_epi32(x0, _mm256_set1_epi32(p - 1));
+        before[p] = after[p] = gather(tops, _mm256_min_epi32(_mm256_max_epi32(c, zero), lastCol));
+    }
+
+    __m256i holes = zero, aggregate = zero;
+    for (int j = 0; j < 4; ++j) {
+        const __m256i active = _mm256_cmpgt_epi32(width, _mm256_set1_epi32(j));
+        const __m256i top    = before[j + 1];
+        const __m256i pieceTop = _mm256_add_epi32(y0, gather(footprints.colTop[j], fp));
+        const __m256i count    = gather(footprints.colCount[j], fp);
+        const __m256i covers   = _mm256_cmpgt_epi32(top, pieceTop);
+        const __m256i newTop   = _mm256_min_epi32(top, pieceTop);
+
+        const __m256i buried = _mm256_sub_epi32(_mm256_sub_epi32(top, pieceTop), count);
+        const __m256i filled = _mm256_sub_epi32(zero, count);
+        holes   = _mm256_add_epi32(holes, _mm256_and_si256(active, _mm256_blendv_epi8(filled, buried, covers)));
+        aggregate = _mm256_add_epi32(aggregate, _mm256_and_si256(active, _mm256_sub_epi32(top, newTop)));
+        after[j + 1] = _mm256_blendv_epi8(top, newTop, active);
+    }
+
+    __m256i bump = zero;
+    for (int p = 0; p < 5; ++p) {
+        const __m256i c      = _mm256_add_epi32(x0, _mm256_set1_epi32(p - 1));
+        const __m256i inside = _mm256_andnot_si256(_mm256_cmpgt_epi32(zero, c), _mm256_cmpgt_epi32(lastCol, c));
+        const __m256i used   = _mm256_andnot_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(p), width), inside);
+        const __m256i delta  = _mm256_sub_epi32(_mm256_abs_epi32(_mm256_sub_epi32(after[p], after[p + 1])),
+                                                _mm256_abs_epi32(_mm256_sub_epi32(before[p], before[p + 1])));
+        bump = _mm256_add_epi32(bump, _mm256_and_si256(used, delta));
+    }
+
+    alignas(32) int32_t contactsLane[W], clearedLane[W], holesLane[W], aggregateLane[W], bumpLane[W];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(contactsLane), contacts);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(clearedLane), cleared);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(holesLane), holes);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(aggregateLane), aggregate);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(bumpLane), bump);
+
+    for (int i = 0; i < W; ++i) {
+        if (clipped[i]) { out[i] = evaluateClipped(field, locks[i]); continue; }
+        FeatureKernel::Features& f = out[i];
+        const int fpi = fpLane[i];
+        f.clearedLines    = field.countFullLines() + clearedLane[i];
+        f.aggregateHeight = field.getAggregateHeight() + aggregateLane[i];
+        f.holes           = field.getTotalHoles() + holesLane[i];
+        f.bumpiness       = field.getBumpiness() + bumpLane[i];
+        f.contacts        = contactsLane[i];
+        f.minX = x0Lane[i];
+        f.maxX = x0Lane[i] + footprints.width[fpi] - 1;
+        f.minY = y0Lane[i];
+        f.sumX = 4 * x0Lane[i] + footprints.sumDx[fpi];
+    }
+}
+#endif
+}
+
+FeatureKernel::Features FeatureKernel::evaluate(const Playfield& field, const Shape& locked) noexcept {
+    const int fp = footprintOf(locked);
+    const int x0 = locked.getOriginX() + footprints.dx[fp];
+    const int y0 = locked.getOriginY() + footprints.dy[fp];
+    if (!fitsInside(field, fp, x0, y0)) return evaluateClipped(field, locked);
+
+    const int cols = field.getCols();
+    const int w    = footprints.width[fp];
+    const int h    = footprints.height[fp];
+
+    Features f;
+    f.minX = x0;
+    f.maxX = x0 + w - 1;
+    f.minY = y0;
+    f.sumX = 4 * x0 + footprints.sumDx[fp];
+
+    const RowMask* padded   = field.getPaddedRows();
+    const RowMask  full     = field.getFullMask();
+    const RowMask  rightBit = RowMask(1u) << (cols - 1);
+    int cleared = 0;
+    for (int k = 0; k < h; ++k) {
+        const RowMask  piece = RowMask(footprints.rowBits[k][fp]) << x0;
+        const RowMask* r     = padded + y0 + k;   // r[0] above, r[1] this row, r[2] below
+        f.contacts += __builtin_popcount(piece & r[0])
+                    + __builtin_popcount(piece & r[2])
+                    + __builtin_popcount(piece & ((r[1] << 1) | 1u))
+                    + __builtin_popcount(piece & ((r[1] >> 1) | rightBit));
+        cleared += (r[1] | piece) == full;
+    }
+
+    const int* tops = field.getColumnTops();
+    int newTops[4];
+    int holes = 0, height = 0, bump = 0;
+    for (int j = 0; j < w; ++j) {
+        const int top      = tops[x0 + j];
+        const int pieceTop = y0 + footprints.colTop[j][fp];
+        const int count    = footprints.colCount[j][fp];
+        if (pieceTop < top) {
+            holes  += top - pieceTop - count;
+            height += top - pieceTop;
+            newTops[j] = pieceTop;
+        } else {
+            holes  -= count;
+            newTops[j] = top;
+        }
+    }
+    auto topAfter = [&](int c) { return (c >= x0 && c < x0 + w) ? newTops[c - x0] : tops[c]; };
+    for (int c = std::max(0, x0 - 1); c <= std::min(cols - 2, x0 + w - 1); ++c) {
+        bump += std::abs(topAfter(c) - topAfter(c + 1)) - std::abs(tops[c] - tops[c + 1]);
+    }
+
+    f.clearedLines    = field.countFullLines() + cleared;
+    f.aggregateHeight = field.getAggregateHeight() + height;
+    f.holes           = field.getTotalHoles() + holes;
+    f.bumpiness       = field.getBumpiness() + bump;
+    return f;
+}
+
+void FeatureKernel::evaluate(const Playfield& field, const Shape* locks, int count, Features* out) noexcept {
+    int i = 0;
+#ifdef TETRIS_FEATURE_AVX2
+    if (hasAvx2()) {
+        for (; i + BatchWidth <= count; i += BatchWidth) evaluateAvx2(field, locks + i, out + i);
+    }
+#endif
+    for (; i < count; ++i) out[i] = evaluate(field, locks[i]);
+}
+
+int FeatureKernel::countContacts(const Playfield& field, const Shape& shape) noexcept {
+    return evaluate(field, shape).contacts;
+}
+
+bool FeatureKernel::hasAvx2() noexcept {
+#ifdef TETRIS_FEATURE_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Playfield.hpp"
+#include "Shape.hpp"
+
+// Board features after a piece locks, read from the row bitmasks and the
+// incremental column stats of a Playfield. Every placement heuristic goes
+// through here so they all measure the same thing.
+class FeatureKernel {
+public:
+    static constexpr int BatchWidth = 8;
+
+    struct Features {
+        int clearedLines    = 0;
+        int aggregateHeight = 0;
+        int holes           = 0;
+        int bumpiness       = 0;
+        int contacts        = 0;   // cell edges touching walls, floor or stack
+
+        // Footprint of the locked piece.
+        int minX = 0, maxX = -1;
+        int minY = 0;
+        int sumX = 0;
+    };
+
+    static Features evaluate(const Playfield& field, const Shape& locked) noexcept;
+    // Same results as evaluate() for each lock; runs BatchWidth locks per
+    // step with AVX2 when the CPU has it.
+    static void evaluate(const Playfield& field, const Shape* locks, int count, Features* out) noexcept;
+
+    static int  countContacts(const Playfield& field, const Shape& shape) noexcept;
+    static bool hasAvx2() noexcept;
+};
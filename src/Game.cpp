@@ -1,42 +1,17 @@
 #include "Game.hpp"
 #include <array>
-
-namespace {
-struct CoordsKey {
-    std::array<int, 8> a{};
-    bool operator==(const CoordsKey& o) const noexcept { return a == o.a; }
-};
-
-inline CoordsKey makeKey(const Shape& s) {
-    std::array<std::pair<int,int>, 4> pts;
-    int i=0;
-    for (auto p : s.getCoords()) pts[i++] = p;
-    std::sort(pts.begin(), pts.end(), [](auto& L, auto& R){
-        if (L.second != R.second) return L.second < R.second;
-        return L.first < R.first;
-    });
-    CoordsKey k;
-    int j=0;
-    for (auto& p : pts) { k.a[j++] = p.first; k.a[j++] = p.second; }
-    return k;
-}
-struct KeyHash {
-    size_t operator()(const CoordsKey& k) const noexcept {
-        size_t h = 1469598103934665603ull;
-        for (int v : k.a) { h ^= std::hash<int>{}(v); h *= 1099511628211ull; }
-        return h;
-    }
-};
-}
+#include <fstream>
 
 Game::Game(int windowWidth, int windowHeight, int cellSize, std::optional<uint32_t> seed)
-    : board(20, 10, cellSize, {0, 0, 255, 255}, seed.has_value() ? (*seed ^ 0x9E3779B9u) : std::random_device{}()),
-      currentShape(Shape::Type::O, board.getCols() / 2, 0, {255, 255, 255, 255}),
-      shadowShape(currentShape),
+    : core(20, 10, seed.has_value() ? *seed : std::random_device{}()),
+      boardRenderer(core.getBoard().getRows(), core.getBoard().getCols(), cellSize, {0, 0, 255, 255},
+                    seed.has_value() ? (*seed ^ 0x9E3779B9u) : std::random_device{}()),
+      shadowShape(core.getCurrentShape()),
+      ghostSource(core.getCurrentShape()),
       cellSize(cellSize),
       windowWidth(windowWidth),
       windowHeight(windowHeight),
-      rng(seed.has_value() ? std::mt19937(*seed) : std::mt19937(std::random_device{}())) {
+      mousePlanner(planner) {
     if (SDL_Init(SDL_INIT_VIDEO) < 0)
         throw std::runtime_error("SDL Initialization failed");
 
@@ -81,10 +56,13 @@ Game::Game(int windowWidth, int windowHeight, int cellSize, std::optional<uint32
     if (!renderer) {
         throw std::runtime_error("Failed to create renderer");
     }
+    textRenderer = std::make_unique<TextRenderer>(renderer);
     
-    board.initializeTexture(renderer);
-    board.rebuildGridBackground(renderer);
-    board.prewarm(renderer);
+    shadowShape.translate(0, core.getBoard().dropDistance(shadowShape));
+
+    boardRenderer.initializeTexture(renderer);
+    boardRenderer.rebuildGridBackground(renderer);
+    boardRenderer.prewarm(renderer);
     warmupOnce();
     scorePopups.reserve(16);
 
@@ -282,13 +260,23 @@ Game::Game(int windowWidth, int windowHeight, int cellSize, std::optional<uint32
     );
     doneBtn->visible = false;
 
-    spawnNewShape();
-    for (int i = 0; i < 7; ++i) {
-        Shape s(static_cast<Shape::Type>(i), board.getCols() / 2, 0, {255,255,255,255});
-        computeReachableLocks(s);
+    planner.setWorkerPool(&plannerPool);
+    planner.setCacheCapacity(64, 1024);
+    // Tuned weights from tetris-tune, if any were installed.
+    if (std::ifstream("assets/weights.txt")) {
+        try {
+            planner.setWeights(PlacementWeights::load("assets/weights.txt"));
+        } catch (const std::exception& e) {
+            SDL_Log("Ignoring weights file, using defaults: %s", e.what());
+        }
+    }
+    for (int i = 0; i < Shape::TypeCount; ++i) {
+        Shape s(static_cast<Shape::Type>(i), core.getBoard().getCols() / 2, 0);
+        planner.planBestPlacement(core.getBoard(), s);
     }
     resumeCountdownActive = true;
     countdownStartTime = SDL_GetTicks();
+    lastStepTime = countdownStartTime;
 }
 
 Game::~Game() {
@@ -302,6 +290,10 @@ Game::~Game() {
     SoundManager::CleanUp();
     Mix_CloseAudio();
 
+    textRenderer.reset();
+    ShapeRenderer::clearCache();
+    clear_draw_cache();
+    FormUI::Shutdown();
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
     
@@ -331,8 +323,27 @@ void Game::run() {
     }
 }
 
+// Render targets lose their contents on these events, so the tile atlas,
+// grid background and stack layer are redrawn from scratch. A device reset
+// loses every texture, so the static caches are dropped as well.
+void Game::handleRenderReset(const SDL_Event& e) {
+    if (e.type != SDL_RENDER_TARGETS_RESET && e.type != SDL_RENDER_DEVICE_RESET) return;
+
+    if (e.type == SDL_RENDER_DEVICE_RESET) {
+        clear_draw_cache();
+        ShapeRenderer::clearCache();
+        textRenderer->clear();
+        UITextTexture::releaseAll();
+    }
+    boardRenderer.initializeTexture(renderer);
+    boardRenderer.rebuildGridBackground(renderer);
+    boardRenderer.invalidateStackLayer();
+}
+
 void Game::processInput() {
+    const Board& board = core.getBoard();
     mouseMovedThisFrame = false;
+    pendingInputs = {};
     if (soundEnabled != lastSoundEnabled) {
         if (soundEnabled) {
             SoundManager::Load();
@@ -349,6 +360,7 @@ void Game::processInput() {
     if (board.isClearingLines) {
         SDL_Event e;
         while (SDL_PollEvent(&e)) {
+            handleRenderReset(e);
             if (e.type == SDL_QUIT) {
                 running = false;
             }
@@ -358,6 +370,7 @@ void Game::processInput() {
 
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
+        handleRenderReset(e);
         inputHandler.handleEvent(e);
         FormUI::HandleEvent(e);
 
@@ -454,7 +467,7 @@ void Game::processInput() {
     }
 
     Uint32 currentTime = SDL_GetTicks();
-    auto clearPlannerOnKeyboard = [&](){ plannedMouseLock.reset(); };
+    auto clearPlannerOnKeyboard = [&](){ resetMousePlan(); };
     if (inputHandler.isKeyJustPressed(keyBindings[Action::MoveLeft])  ||
         inputHandler.isKeyJustPressed(keyBindings[Action::MoveRight]) ||
         inputHandler.isKeyJustPressed(keyBindings[Action::RotateLeft])||
@@ -472,26 +485,17 @@ void Game::processInput() {
 
     if (inputHandler.isKeyPressed(keyBindings[Action::MoveLeft])) {
         if (!leftKeyHandled) {
-            if (!board.isOccupied(currentShape.getCoords(), -1, 0)) {
-                currentShape.moveLeft();
-                if (soundEnabled) SoundManager::PlayMoveSound();
-            }
+            pendingInputs.shift -= 1;
             leftKeyHandled = true;
             leftLastMoveTime = currentTime;
             leftFirstRepeat = true;
         } else {
             if (leftFirstRepeat && currentTime - leftLastMoveTime >= autoRepeatInitialDelay) {
-                if (!board.isOccupied(currentShape.getCoords(), -1, 0)) {
-                    currentShape.moveLeft();
-                    if (soundEnabled) SoundManager::PlayMoveSound();
-                }
+                pendingInputs.shift -= 1;
                 leftLastMoveTime = currentTime;
                 leftFirstRepeat = false;
             } else if (!leftFirstRepeat && currentTime - leftLastMoveTime >= autoRepeatInterval) {
-                if (!board.isOccupied(currentShape.getCoords(), -1, 0)) {
-                    currentShape.moveLeft();
-                    if (soundEnabled) SoundManager::PlayMoveSound();
-                }
+                pendingInputs.shift -= 1;
                 leftLastMoveTime = currentTime;
             }
         }
@@ -505,26 +509,17 @@ void Game::processInput() {
 
     if (inputHandler.isKeyPressed(keyBindings[Action::MoveRight])) {
         if (!rightKeyHandled) {
-            if (!board.isOccupied(currentShape.getCoords(), 1, 0)) {
-                currentShape.moveRight(board.getCols());
-                if (soundEnabled) SoundManager::PlayMoveSound();
-            }
+            pendingInputs.shift += 1;
             rightKeyHandled = true;
             rightLastMoveTime = currentTime;
             rightFirstRepeat = true;
         } else {
             if (rightFirstRepeat && currentTime - rightLastMoveTime >= autoRepeatInitialDelay) {
-                if (!board.isOccupied(currentShape.getCoords(), 1, 0)) {
-                    currentShape.moveRight(board.getCols());
-                    if (soundEnabled) SoundManager::PlayMoveSound();
-                }
+                pendingInputs.shift += 1;
                 rightLastMoveTime = currentTime;
                 rightFirstRepeat = false;
             } else if (!rightFirstRepeat && currentTime - rightLastMoveTime >= autoRepeatInterval) {
-                if (!board.isOccupied(currentShape.getCoords(), 1, 0)) {
-                    currentShape.moveRight(board.getCols());
-                    if (soundEnabled) SoundManager::PlayMoveSound();
-                }
+                pendingInputs.shift += 1;
                 rightLastMoveTime = currentTime;
             }
         }
@@ -546,25 +541,26 @@ void Game::processInput() {
             int targetGridX = std::clamp(mouseX / cellSize, 0, board.getCols()-1);
             int targetGridY = std::clamp(mouseY / cellSize, 0, board.getRows()-1);
 
+            Shape active = core.getCurrentShape();
             if (mouseMovedThisFrame) {
-                snapShapeHorizontally(targetGridX);
+                snapShapeHorizontally(active, targetGridX);
+            }
+
+            if (auto result = mousePlanner.poll()) {
+                applyMousePlan(*result, active);
+            }
+            if (plannedMouseLock && plannedCoversTarget) {
+                alignToShape(active, *plannedMouseLock);
             }
 
-            static Uint32 lastAutoPlace = 0;
             const Uint32 intervalMs = 16;
-            Uint32 now = SDL_GetTicks();
-            if (now - lastAutoPlace >= intervalMs) {
-                if (!plannedMouseLock || !plannedCoversTarget) {
-                    autoRotateCurrentShape(targetGridX, targetGridY);
-                }
-                planMousePlacement(targetGridX, targetGridY);
-                if (plannedMouseLock && plannedCoversTarget) {
-                    alignToPlannedLock();
-                }
-                lastAutoPlace = now;
+            if (currentTime - lastPlanRequestTime >= intervalMs) {
+                requestMousePlan(active, targetGridX, targetGridY);
+                lastPlanRequestTime = currentTime;
             }
+            pendingInputs.moveTo = active;
         } else {
-            plannedMouseLock.reset();
+            resetMousePlan();
         }
     }
 
@@ -572,7 +568,7 @@ void Game::processInput() {
     static bool rotationKeyHandled = false;
     if (inputHandler.isKeyJustPressed(keyBindings[Action::RotateRight])) {
         if (!rotationKeyHandled) {
-            currentShape.rotateClockwise(board.getGrid(), board.getCols(), board.getRows());
+            pendingInputs.rotation += 1;
             rotationKeyHandled = true;
         }
     } else {
@@ -580,14 +576,12 @@ void Game::processInput() {
     }
 
     if (inputHandler.isKeyJustPressed(keyBindings[Action::RotateLeft])) {
-        currentShape.rotateCounterClockwise(board.getGrid(), board.getCols(), board.getRows());
+        pendingInputs.rotation -= 1;
     }
 
     if (inputHandler.isKeyPressed(keyBindings[Action::SoftDrop]) && currentTime - lastDownMoveTime >= downMoveDelay) {
-        if (!board.isOccupied(currentShape.getCoords(), 0, 1)) {
-            currentShape.moveDown();
-            if (soundEnabled) SoundManager::PlayMoveSound();
-            updateScore(0, 1, false);
+        if (!board.isOccupied(core.getCurrentShape(), 0, 1)) {
+            pendingInputs.softDrop = true;
             lastDownMoveTime = currentTime;
         }
     }
@@ -600,8 +594,7 @@ void Game::processInput() {
     if (mouseControlEnabled) {
         if (inputHandler.isRightMouseClicked()) {
             if (ignoreNextMouseClick) { ignoreNextMouseClick = false; return; }
-            holdPiece();
-            if (soundEnabled) SoundManager::PlayHoldSound();
+            pendingInputs.hold = true;
             return;
         }
         if (inputHandler.isLeftMouseClicked()) {
@@ -620,13 +613,16 @@ void Game::processInput() {
     }
 
     if (inputHandler.isKeyJustPressed(keyBindings[Action::Hold])) {
-        holdPiece();
-        if (soundEnabled) SoundManager::PlayHoldSound();
+        pendingInputs.hold = true;
     }
 }
 
 
 void Game::update() {
+    const Uint32 frameTime = SDL_GetTicks();
+    const Uint32 dt = frameTime - lastStepTime;
+    lastStepTime = frameTime;
+
     mouseMovedThisFrame = false;
     updateScorePopups();
     bool gameOver = isGameOver();
@@ -665,44 +661,43 @@ void Game::update() {
         isMusicPlaying = true;
     }
 
-    board.updateAnimations();
-
+    boardRenderer.updateAnimations();
 
-    Uint32 currentTime = SDL_GetTicks();
+    handleCoreEvents(core.step(pendingInputs, dt));
+    pendingInputs = {};
 
-    if (board.isClearingLines) {
-        if (currentTime - board.clearStartTime >= 500) {
-            board.finalizeLineClear();
-            spawnNewShape();
-            if (isGameOver()) return;
-        }
-        return;
+    const Board& board   = core.getBoard();
+    const Shape& current = core.getCurrentShape();
+    if (current != ghostSource || board.hash() != ghostBoardHash) {
+        shadowShape = current;
+        shadowShape.translate(0, board.dropDistance(current));
+        ghostSource    = current;
+        ghostBoardHash = board.hash();
     }
+}
 
-    if (currentTime - lastMoveTime >= static_cast<Uint32>(speed)) {
-        if (!board.isOccupied(currentShape.getCoords(), 0, 1)) {
-            currentShape.moveDown();
-            if (soundEnabled) SoundManager::PlayMoveSound();
-        } else {
-            board.placeShape(currentShape);
-            if (soundEnabled) SoundManager::PlayDropSound();
-
-            int clearedLines = board.clearFullLines();
-            updateScore(clearedLines, 0, false);
+void Game::handleCoreEvents(const GameCore::Events& events) {
+    if (events.moved && soundEnabled) SoundManager::PlayMoveSound();
+    if (events.held) {
+        resetMousePlan();
+        if (soundEnabled) SoundManager::PlayHoldSound();
+    }
 
-            if (clearedLines > 0) {
-                board.clearStartTime = currentTime;
-            } else {
-                spawnNewShape();
-                if (isGameOver()) return;
-            }
+    if (events.locked) {
+        boardRenderer.triggerLandingAnim(*events.locked);
+        if (events.hardDropped) {
+            boardRenderer.triggerHardDropAnim(*events.locked);
         }
-        lastMoveTime = currentTime;
+        resetMousePlan();
+        if (soundEnabled) SoundManager::PlayDropSound();
     }
 
-    shadowShape = currentShape;
-    while (!board.isOccupied(shadowShape.getCoords(), 0, 1)) {
-        shadowShape.moveDown();
+    if (events.clearedLines > 0) {
+        if (soundEnabled) SoundManager::PlayClearSound();
+        triggerScorePopup(events.clearedLines, events.points);
+    }
+    if (events.levelUp) {
+        triggerLevelUpPopup();
     }
 }
 
@@ -715,17 +710,20 @@ void Game::render() {
     }
 
     if (isPaused || currentScreen == Screen::Settings) {
-        board.draw(renderer, UI::BoardOffsetX, UI::BoardOffsetY, false);
+        boardRenderer.draw(renderer, core.getBoard(), UI::BoardOffsetX, UI::BoardOffsetY, false,
+                           core.getLineClearProgress());
     } else {
-        board.draw(renderer, UI::BoardOffsetX, UI::BoardOffsetY, !resumeCountdownActive);
-        if (!resumeCountdownActive && !isGameOver() && !board.isClearingLines) {
+        boardRenderer.draw(renderer, core.getBoard(), UI::BoardOffsetX, UI::BoardOffsetY, !resumeCountdownActive,
+                           core.getLineClearProgress());
+        if (!resumeCountdownActive && !isGameOver() && !core.getBoard().isClearingLines) {
+            const int cs = boardRenderer.getCellSize();
             if (mouseControlEnabled && plannedMouseLock.has_value() && plannedCoversTarget) {
-                plannedMouseLock->draw(renderer, board.getCellSize(), UI::BoardOffsetX, UI::BoardOffsetY, true);
+                ShapeRenderer::draw(renderer, *plannedMouseLock, cs, UI::BoardOffsetX, UI::BoardOffsetY, true);
             } else {
-                shadowShape.draw(renderer, board.getCellSize(), UI::BoardOffsetX, UI::BoardOffsetY, true);
+                ShapeRenderer::draw(renderer, shadowShape, cs, UI::BoardOffsetX, UI::BoardOffsetY, true);
             }
             
-            currentShape.draw(renderer, board.getCellSize(), UI::BoardOffsetX, UI::BoardOffsetY);
+            ShapeRenderer::draw(renderer, core.getCurrentShape(), cs, UI::BoardOffsetX, UI::BoardOffsetY);
         }
     }
 
@@ -778,11 +776,11 @@ void Game::render() {
     const int linesCardY = cardsStartY + 2 * (cardHeight + cardMargin);
 
     renderInfoCard(cardsX, scoreCardY, cardWidth, cardHeight, cornerRadius,
-                   "SCORE", std::to_string(score));
+                   "SCORE", std::to_string(core.getScore()));
     renderInfoCard(cardsX, levelCardY, cardWidth, cardHeight, cornerRadius,
-                   "LEVEL", std::to_string(level));
+                   "LEVEL", std::to_string(core.getLevel()));
     renderInfoCard(cardsX, linesCardY, cardWidth, cardHeight, cornerRadius,
-                   "LINES", std::to_string(totalLinesCleared));
+                   "LINES", std::to_string(core.getTotalLinesCleared()));
 
     FormUI::Render(renderer);
 
@@ -825,169 +823,18 @@ void Game::render() {
 
 
 bool Game::isGameOver() const noexcept {
-    if (board.isClearingLines) return false;
-    return board.isOccupied(currentShape.getCoords(), 0, 0);
+    return core.isGameOver();
 }
 
 
-void Game::autoRotateCurrentShape(int targetGridX, int targetGridY) {
-    constexpr int CONTACT_W  = 20;
-    const int ANCHOR_W   = autoPlaceAnchorW;
-    constexpr int STAB_W     = 15;
-    constexpr int ANCHOR_CAP = 2;
-    constexpr int FILL_BONUS = 1'000'000;
-
-    const int rows = board.getRows();
-    const int cols = board.getCols();
-    const auto& grid = board.getGrid();
-    const Shape original = currentShape;
-
-    static std::vector<std::vector<int>> scratch;
-    scratch.assign(rows, std::vector<int>(cols, 0));
-    for (int r = 0; r < rows; ++r)
-        for (int c = 0; c < cols; ++c)
-            scratch[r][c] = grid[r][c] ? 1 : 0;
-
-    struct RotInfo {
-        Shape shape;
-        int   minX, maxX, width;
-        explicit RotInfo(const Shape& s) : shape(s), minX(0), maxX(0), width(0) {}
-    };
-
-    auto computeBounds = [&](const Shape& s, int& mn, int& mx) {
-        mn = cols; mx = -1;
-        for (const auto& c : s.getCoords()) { mn = std::min(mn, c.first); mx = std::max(mx, c.first); }
-    };
-
-    std::vector<RotInfo> rots; rots.reserve(4);
-
-    RotInfo r0(original);
-    computeBounds(r0.shape, r0.minX, r0.maxX);
-    r0.width = r0.maxX - r0.minX + 1;
-    rots.push_back(std::move(r0));
-
-    for (int i = 1; i < 4; ++i) {
-        RotInfo ri(rots.back().shape);
-        ri.shape.rotateClockwise(grid, cols, rows);
-        computeBounds(ri.shape, ri.minX, ri.maxX);
-        ri.width = ri.maxX - ri.minX + 1;
-        rots.push_back(std::move(ri));
-    }
-
-    int bestScore = std::numeric_limits<int>::min();
-    int bestTie   = std::numeric_limits<int>::max();
-    Shape best    = currentShape;
-    bool foundAny = false;
-
-    auto evalRange = [&](const RotInfo& base, int startX, int endX) {
-        bool localFound = false;
-        for (int xLeft = startX; xLeft <= endX; ++xLeft)
-        {
-            Shape cand = base.shape;
-            int dxShift = xLeft - base.minX;
-            for (auto& p : cand.coords) p.first += dxShift;
-            if (board.isOccupied(cand.getCoords(), 0, 0)) continue;
-
-            Shape dropped = cand;
-            while (!board.isOccupied(dropped.getCoords(), 0, 1))
-                dropped.moveDown();
-
-            for (const auto& p : dropped.getCoords())
-                if (p.second >= 0 && p.second < rows && p.first >= 0 && p.first < cols)
-                    scratch[p.second][p.first] = 1;
-
-            int cleared = 0;
-            for (int r = 0; r < rows; ++r) {
-                bool full = true;
-                for (int c = 0; c < cols; ++c) { if (!scratch[r][c]) { full = false; break; } }
-                if (full) ++cleared;
-            }
-
-            int aggregate = 0, holes = 0, bumpiness = 0;
-            std::vector<int> heights(cols, 0);
-            for (int c = 0; c < cols; ++c) {
-                for (int r = 0; r < rows; ++r) {
-                    if (scratch[r][c]) { heights[c] = rows - r; aggregate += heights[c]; break; }
-                }
-            }
-            for (int c = 0; c < cols; ++c) {
-                bool seen = false;
-                for (int r = 0; r < rows; ++r) { if (scratch[r][c]) seen = true; else if (seen) ++holes; }
-            }
-            for (int c = 0; c < cols - 1; ++c) bumpiness += std::abs(heights[c] - heights[c+1]);
-
-            int contacts = countContactSegments(dropped, board);
-
-            int fmin = cols, fmax = -1, centreX = 0, minY = rows;
-            for (const auto& p : dropped.getCoords()) {
-                fmin = std::min(fmin, p.first);
-                fmax = std::max(fmax, p.first);
-                centreX += p.first;
-                minY = std::min(minY, p.second);
-            }
-            centreX /= (int)dropped.getCoords().size();
-
-            int rawDist = 0;
-            if (targetGridX < fmin) rawDist = fmin - targetGridX;
-            else if (targetGridX > fmax) rawDist = targetGridX - fmax;
-            int anchorDist = std::max(0, rawDist - 1);
-            anchorDist     = std::min(anchorDist, ANCHOR_CAP);
-            int anchorPen  = -ANCHOR_W * anchorDist * anchorDist;
-
-            int dxPivot = std::abs(cand.coords[0].first - original.coords[0].first);
-
-            bool fillsTarget = false;
-            if (targetGridY >= 0 && targetGridY < rows)
-                for (const auto& p : dropped.getCoords())
-                    if (p.first == targetGridX && p.second == targetGridY) { fillsTarget = true; break; }
-
-            int yAlignBonus = 0;
-            if (targetGridY >= 0 && targetGridY < rows)
-                yAlignBonus = -std::abs(minY - targetGridY) * 5;
-
-            int score =
-                  cleared      * 1000
-                + aggregate    *   -7
-                + holes        * -120
-                + bumpiness    *   -4
-                + contacts     *  CONTACT_W
-                + anchorPen
-                + dxPivot      *  -STAB_W
-                + (fillsTarget ? FILL_BONUS : 0)
-                + yAlignBonus;
-
-            int tie = std::max(0, std::abs(centreX - targetGridX) - 1);
-
-            if (score > bestScore || (score == bestScore && tie < bestTie)) {
-                bestScore = score; bestTie = tie; best = cand; localFound = true;
-            }
-
-            for (const auto& p : dropped.getCoords())
-                if (p.second >= 0 && p.second < rows && p.first >= 0 && p.first < cols)
-                    scratch[p.second][p.first] = grid[p.second][p.first] ? 1 : 0;
-        }
-        return localFound;
-    };
-
-    for (const auto& base : rots)
-    {
-        int W = autoPlaceWindow;
-        int startX = std::max(0, targetGridX - W);
-        int endX   = std::min(cols - base.width, targetGridX + W);
-        if (startX <= endX) foundAny |= evalRange(base, startX, endX);
-        if (!foundAny && cols - base.width >= 0) foundAny |= evalRange(base, 0, cols - base.width);
-    }
-
-    currentShape = best;
-}
-
-void Game::snapShapeHorizontally(int targetX) {
+void Game::snapShapeHorizontally(Shape& shape, int targetX) {
+    const Board& board = core.getBoard();
     int minX = INT_MAX, maxX = INT_MIN;
-    for (auto &c : currentShape.coords) {
+    for (const auto& c : shape.getCoords()) {
         minX = std::min(minX, c.first);
         maxX = std::max(maxX, c.first);
     }
-    const int leftBias = (currentShape.getType() == Shape::Type::O) ? 1 : 0;
+    const int leftBias = (shape.getType() == Shape::Type::O) ? 1 : 0;
     int desiredMinX = std::clamp(targetX - leftBias, 0, board.getCols() - (maxX - minX + 1));
     int dx = desiredMinX - minX;
 
@@ -1000,8 +847,8 @@ void Game::snapShapeHorizontally(int targetX) {
 
     int dir = (mouseXAccumulator > 0.0f) ? 1 : -1;
     for (int i = 0; i < steps; ++i) {
-        if (!board.isOccupied(currentShape.getCoords(), dir, 0)) {
-            for (auto &c : currentShape.coords) c.first += dir;
+        if (!board.isOccupied(shape, dir, 0)) {
+            shape.translate(dir, 0);
             mouseXAccumulator -= dir;
         } else {
             mouseXAccumulator = 0.0f;
@@ -1011,7 +858,7 @@ void Game::snapShapeHorizontally(int targetX) {
 }
 
 void Game::renderNextPieces() {
-    const int sidebarX = board.getCols() * cellSize + 300;
+    const int sidebarX = core.getBoard().getCols() * cellSize + 300;
     const int sidebarY = 70;
     const int sidebarWidth = 150;
     const int sidebarHeight = 400;
@@ -1033,17 +880,12 @@ void Game::renderNextPieces() {
 
     SDL_Color titleColor = {20, 25, 51, 255};
     
-    SDL_Surface* textSurface = TTF_RenderText_Blended(fontMedium, "NEXT", titleColor);
-    if (textSurface) {
-        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-        if (textTexture) {
-            int textX = sidebarX + (sidebarWidth - textSurface->w) / 2;
-            int textY = sidebarY + (titleAreaHeight - textSurface->h) / 2;
-            SDL_Rect textRect = {textX, textY, textSurface->w, textSurface->h};
-            SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-            SDL_DestroyTexture(textTexture);
-        }
-        SDL_FreeSurface(textSurface);
+    int textW = 0, textH = 0;
+    if (SDL_Texture* textTexture = textRenderer->label(fontMedium, "NEXT", titleColor, &textW, &textH)) {
+        int textX = sidebarX + (sidebarWidth - textW) / 2;
+        int textY = sidebarY + (titleAreaHeight - textH) / 2;
+        SDL_Rect textRect = {textX, textY, textW, textH};
+        SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
     }
 
     bool showNextPieces = (!resumeCountdownActive && !isPaused && currentScreen != Screen::Settings && !isGameOver());
@@ -1053,11 +895,12 @@ void Game::renderNextPieces() {
     int spacing = 20;
     int slotHeight = 80;
 
-    for (size_t i = 0; i < std::min(nextPieces.size(), size_t(3)); i++) {
+    const auto& nextPieces = core.getNextPieces();
+    for (size_t i = 0; i < std::min(nextPieces.size(), size_t(GameCore::PreviewCount)); i++) {
         const auto& shape = nextPieces[i];
         tmpCoords.clear();
         shape.getLocalCoords(tmpCoords);
-        SDL_Color color = shape.getColor();
+        SDL_Color color = ShapeRenderer::colorOf(shape);
 
         int minX = 0, maxX = 0;
         int minY = 0, maxY = 0;
@@ -1090,69 +933,6 @@ void Game::renderNextPieces() {
 
 
 
-void Game::spawnNewShape() {
-    if (nextPieces.empty()) {
-        for (int i = 0; i < 3; i++) {
-            std::uniform_int_distribution<int> dist(0, 6);
-            Shape::Type newType = static_cast<Shape::Type>(dist(rng));
-            nextPieces.push_back(Shape(newType, board.getCols() / 2, 0, {255, 255, 255, 255}));
-        }
-    }
-
-    currentShape = nextPieces.front();
-    nextPieces.pop_front();
-
-    if (isGameOver()) {
-        return;
-    }
-
-    {
-        std::uniform_int_distribution<int> dist(0, 6);
-        Shape::Type newType = static_cast<Shape::Type>(dist(rng));
-        nextPieces.push_back(Shape(newType, board.getCols() / 2, 0, {255, 255, 255, 255}));
-    }
-
-    canHold = true;
-    lastMouseTargetGridX = std::numeric_limits<int>::min();
-}
-
-
-
-void Game::checkLevelUp() {
-    int newLevel = (totalLinesCleared / 10) + 1;
-
-    if (newLevel > level) {
-        level = newLevel;
-        updateSpeed();
-        triggerLevelUpPopup();
-    }
-}
-
-void Game::updateScore(int clearedLines,int dropDistance, bool hardDrop) {
-    if (clearedLines > 0) {
-        totalLinesCleared += clearedLines;
-        if (soundEnabled) SoundManager::PlayClearSound();
-    }
-
-    int points = 0;
-    switch (clearedLines) {
-        case 1: points += 40;   break;
-        case 2: points += 100;  break;
-        case 3: points += 300;  break;
-        case 4: points += 1200; break;
-    }
-    points *= (level + 1);
-    points += dropDistance * (hardDrop ? 2 : 1);
-    score  += points;
-
-    if (clearedLines > 0) {
-        triggerScorePopup(clearedLines, points);
-    }
-
-    checkLevelUp();
-}
-
-
 void Game::renderText(const std::string& text, int x, int y, SDL_Color color) {
     if (!fontDefault) {
         std::cerr << "Font not initialized!" << std::endl;
@@ -1164,48 +944,11 @@ void Game::renderText(const std::string& text, int x, int y, SDL_Color color) {
         return;
     }
 
-    SDL_Surface* textSurface = TTF_RenderText_Blended(fontDefault, text.c_str(), color);
-    if (!textSurface || textSurface->w == 0) {
-        std::cerr << "Text rendering failed: " << TTF_GetError() << std::endl;
-        return;
-    }
-
-    SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    if (!textTexture) {
-        std::cerr << "Texture creation failed: " << SDL_GetError() << std::endl;
-        SDL_FreeSurface(textSurface);
-        return;
-    }
-
-    SDL_Rect textRect = { x, y, textSurface->w, textSurface->h };
-    SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(textTexture);
+    textRenderer->draw(fontDefault, text, x, y, color);
 }
 
 
 
-void Game::holdPiece() {
-    if (!canHold) return;
-
-    Shape::Type currentType = currentShape.getType();
-    SDL_Color currentColor = currentShape.getColor();
-
-    if (heldShape.has_value()) {
-        Shape::Type heldType = heldShape->getType();
-        SDL_Color heldColor = heldShape->getColor();
-
-        heldShape = Shape(currentType, 0, 0, currentColor);
-        currentShape = Shape(heldType, board.getCols() / 2, 0, heldColor);
-    } else {
-        heldShape = Shape(currentType, 0, 0, currentColor);
-        spawnNewShape();
-    }
-
-    canHold = false;
-}
-
 void Game::renderHoldPiece() {
     const int holdBoxX = 20;
     const int holdBoxY = 70;
@@ -1228,24 +971,20 @@ void Game::renderHoldPiece() {
                    cornerRadius - 1, {20, 25, 51, 255}, true);
 
     SDL_Color titleColor = {20, 25, 51, 255};
-    SDL_Surface* textSurface = TTF_RenderText_Blended(fontMedium, "HOLD", titleColor);
-    if (textSurface) {
-        SDL_Texture* textTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
-        if (textTexture) {
-            int textX = holdBoxX + (holdBoxWidth - textSurface->w) / 2;
-            int textY = holdBoxY + (titleAreaHeight - textSurface->h) / 2;
-            SDL_Rect textRect = {textX, textY, textSurface->w, textSurface->h};
-            SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
-            SDL_DestroyTexture(textTexture);
-        }
-        SDL_FreeSurface(textSurface);
+    int textW = 0, textH = 0;
+    if (SDL_Texture* textTexture = textRenderer->label(fontMedium, "HOLD", titleColor, &textW, &textH)) {
+        int textX = holdBoxX + (holdBoxWidth - textW) / 2;
+        int textY = holdBoxY + (titleAreaHeight - textH) / 2;
+        SDL_Rect textRect = {textX, textY, textW, textH};
+        SDL_RenderCopy(renderer, textTexture, nullptr, &textRect);
     }
 
     bool showHeldPiece = (!resumeCountdownActive && !isPaused && currentScreen != Screen::Settings && !isGameOver());
+    const auto& heldShape = core.getHeldShape();
     if (showHeldPiece && heldShape.has_value()) {
         tmpCoords.clear();
         heldShape->getLocalCoords(tmpCoords);
-        SDL_Color color = heldShape->getColor();
+        SDL_Color color = ShapeRenderer::colorOf(*heldShape);
 
         int minX = 0, maxX = 0;
         int minY = 0, maxY = 0;
@@ -1292,13 +1031,13 @@ void Game::renderGameOverScreen() {
     renderText("GAME OVER", cardX + 90, cardY + 40, textColor);
 
     renderText("Score:",  cardX + 60, cardY + 130, textColor);
-    renderText(std::to_string(score),  cardX + 200, cardY + 130, textColor);
+    renderText(std::to_string(core.getScore()),  cardX + 200, cardY + 130, textColor);
 
     renderText("Lines:",  cardX + 60, cardY + 180, textColor);
-    renderText(std::to_string(totalLinesCleared), cardX + 200, cardY + 180, textColor);
+    renderText(std::to_string(core.getTotalLinesCleared()), cardX + 200, cardY + 180, textColor);
 
     renderText("Level:",  cardX + 60, cardY + 230, textColor);
-    renderText(std::to_string(level), cardX + 200, cardY + 230, textColor);
+    renderText(std::to_string(core.getLevel()), cardX + 200, cardY + 230, textColor);
 
     const int buttonWidth = 180;
     const int buttonHeight = 40;
@@ -1327,13 +1066,8 @@ void Game::resetGame() {
         SoundManager::StopGameOverMusic();
     }
 
-    board.clearBoard();
-    score = totalLinesCleared = 0;
-    level = 1;
-    nextPieces.clear();
-    canHold = true;
-    heldShape.reset();
-    spawnNewShape();
+    core.reset();
+    resetMousePlan();
 
     running = true;
     ignoreNextMouseClick = true;
@@ -1354,24 +1088,6 @@ void Game::resetGame() {
 
 
 
-void Game::updateSpeed() {
-    if (level == 0) speed = 800;
-    else if (level == 1) speed = 717;
-    else if (level == 2) speed = 633;
-    else if (level == 3) speed = 550;
-    else if (level == 4) speed = 467;
-    else if (level == 5) speed = 383;
-    else if (level == 6) speed = 300;
-    else if (level == 7) speed = 217;
-    else if (level == 8) speed = 133;
-    else if (level == 9) speed = 100;
-    else if (level >= 10 && level <= 12) speed = 83;
-    else if (level >= 13 && level <= 15) speed = 67;
-    else if (level >= 16 && level <= 18) speed = 50;
-    else if (level >= 19 && level <= 28) speed = 33;
-    else speed = 16;
-}
-
 void Game::renderPauseMenu() {
     const int cardWidth = 400;
     const int cardHeight = 400;
@@ -1459,72 +1175,17 @@ void Game::renderInfoCard(int x, int y, int width, int height, int radius,
                    radius - 2, {20, 25, 51, 255}, true);
 
     SDL_Color titleColor = {20, 25, 51, 255};
-    SDL_Surface* titleSurface = TTF_RenderText_Blended(fontMedium, title.c_str(), titleColor);
-    if (titleSurface) {
-        SDL_Texture* titleTexture = SDL_CreateTextureFromSurface(renderer, titleSurface);
-        if (titleTexture) {
-            int textX = x + (width - titleSurface->w) / 2;
-            int textY = y + (titleAreaHeight - titleSurface->h) / 2;
-            SDL_Rect textRect = {textX, textY, titleSurface->w, titleSurface->h};
-            SDL_RenderCopy(renderer, titleTexture, nullptr, &textRect);
-            SDL_DestroyTexture(titleTexture);
-        }
-        SDL_FreeSurface(titleSurface);
+    int titleW = 0, titleH = 0;
+    if (SDL_Texture* titleTexture = textRenderer->label(fontMedium, title, titleColor, &titleW, &titleH)) {
+        int textX = x + (width - titleW) / 2;
+        int textY = y + (titleAreaHeight - titleH) / 2;
+        SDL_Rect textRect = {textX, textY, titleW, titleH};
+        SDL_RenderCopy(renderer, titleTexture, nullptr, &textRect);
     }
 
     SDL_Color valueColor = {255, 255, 255, 255};
-    SDL_Surface* valueSurface = TTF_RenderText_Blended(fontDefault, value.c_str(), valueColor);
-    if (valueSurface) {
-        SDL_Texture* valueTexture = SDL_CreateTextureFromSurface(renderer, valueSurface);
-        if (valueTexture) {
-            int textX = innerRect.x + (innerRect.w - valueSurface->w) / 2;
-            int textY = innerRect.y + (innerRect.h - valueSurface->h) / 2;
-            SDL_Rect textRect = {textX, textY, valueSurface->w, valueSurface->h};
-            SDL_RenderCopy(renderer, valueTexture, nullptr, &textRect);
-            SDL_DestroyTexture(valueTexture);
-        }
-        SDL_FreeSurface(valueSurface);
-    }
-}
-
-
-int Game::countContactSegments(const Shape& shape, const Board& board) const {
-    const auto& coords = shape.getCoords();
-    const auto& grid   = board.getGrid();
-    const int   rows   = board.getRows();
-    const int   cols   = board.getCols();
-
-    struct PairHash {
-        size_t operator()(const std::pair<int,int>& p) const noexcept
-        { return (static_cast<size_t>(p.first) << 16) ^ static_cast<size_t>(p.second); }
-    };
-    std::unordered_set<std::pair<int,int>, PairHash> shapeCells(coords.begin(), coords.end());
-
-    const int dx[4] = { 0,  0, -1,  1 };
-    const int dy[4] = { -1, 1,  0,  0 };
-
-    int contacts = 0;
-
-    for (auto [x, y] : coords)
-    {
-        for (int k = 0; k < 4; ++k)
-        {
-            const int nx = x + dx[k];
-            const int ny = y + dy[k];
-
-            if (nx < 0 || nx >= cols || ny < 0 || ny >= rows) {
-                ++contacts;
-                continue;
-            }
-
-            if (shapeCells.find({nx, ny}) != shapeCells.end())
-                continue;
-
-            if (grid[ny][nx] != 0)
-                ++contacts;
-        }
-    }
-    return contacts;
+    textRenderer->drawCentered(fontDefault, value, innerRect.x + innerRect.w / 2, innerRect.y + innerRect.h / 2,
+                               valueColor);
 }
 
 
@@ -1563,44 +1224,9 @@ void Game::renderTextCenteredScaled(const std::string& text, int cx, int cy,
                                     SDL_Color color, float scale, TTF_Font* useFont) {
     if (!useFont || text.empty()) return;
 
-    SDL_Surface* surf = TTF_RenderText_Blended(useFont, text.c_str(), color);
-    if (!surf || surf->w == 0 || surf->h == 0) {
-        if (surf) SDL_FreeSurface(surf);
-        return;
-    }
-
-    SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
-    if (!tex) {
-        SDL_FreeSurface(surf);
-        return;
-    }
-
-    int w = surf->w;
-    int h = surf->h;
-
-    int dstW = static_cast<int>(w * scale);
-    int dstH = static_cast<int>(h * scale);
-    SDL_Rect dst { cx - dstW / 2, cy - dstH / 2, dstW, dstH };
-
     SDL_Color shadowCol { 0, 0, 0, 160 };
-    SDL_Surface* shadowSurf = TTF_RenderText_Blended(useFont, text.c_str(), shadowCol);
-    if (shadowSurf) {
-        SDL_Texture* shadowTex = SDL_CreateTextureFromSurface(renderer, shadowSurf);
-        if (shadowTex) {
-            int sw = shadowSurf->w, sh = shadowSurf->h;
-            int sdw = static_cast<int>(sw * scale);
-            int sdh = static_cast<int>(sh * scale);
-            SDL_Rect shadowDst { cx - sdw / 2 + 4, cy - sdh / 2 + 4, sdw, sdh };
-            SDL_RenderCopy(renderer, shadowTex, nullptr, &shadowDst);
-            SDL_DestroyTexture(shadowTex);
-        }
-        SDL_FreeSurface(shadowSurf);
-    }
-
-    SDL_RenderCopy(renderer, tex, nullptr, &dst);
-
-    SDL_DestroyTexture(tex);
-    SDL_FreeSurface(surf);
+    textRenderer->drawCentered(useFont, text, cx + 4, cy + 4, shadowCol, scale);
+    textRenderer->drawCentered(useFont, text, cx, cy, color, scale);
 }
 
 void Game::triggerScorePopup(const std::string& msg, SDL_Color col, int cx, int cy) {
@@ -1642,8 +1268,8 @@ void Game::updateScorePopups() {
 }
 
 void Game::triggerLevelUpPopup() {
-    const int cx = UI::BoardOffsetX + int(board.getCols() * board.getCellSize() * 0.5f);
-    const int cy = UI::BoardOffsetY + int(board.getCellSize() * 5.5f);
+    const int cx = UI::BoardOffsetX + int(core.getBoard().getCols() * boardRenderer.getCellSize() * 0.5f);
+    const int cy = UI::BoardOffsetY + int(boardRenderer.getCellSize() * 5.5f);
 
     triggerScorePopup("Level up!", SDL_Color{255,255,255,255}, cx, cy);
     auto& p = scorePopups.back();
@@ -1651,220 +1277,54 @@ void Game::triggerLevelUpPopup() {
     p.duration = 1200u;
 }
 
-int Game::minYOf(const Shape& s) noexcept {
-    int my = INT_MAX;
-    for (auto& c : s.getCoords()) my = std::min(my, c.second);
-    return (my == INT_MAX) ? 0 : my;
-}
-bool Game::shapeCoversCell(const Shape& s, int gx, int gy) noexcept {
-    for (auto& c : s.getCoords()) if (c.first == gx && c.second == gy) return true;
-    return false;
-}
-
-std::vector<Shape> Game::computeReachableLocks(const Shape& start) const {
-    const auto& grid = board.getGrid();
-    const int rows = board.getRows(), cols = board.getCols();
-
-    std::vector<Shape> layer;
-    layer.push_back(start);
-
-    std::unordered_set<CoordsKey, KeyHash> globallySeen;
-    globallySeen.insert(makeKey(start));
-
-    std::vector<Shape> locks;
-
-    while (!layer.empty()) {
-        std::deque<Shape> q(layer.begin(), layer.end());
-        std::unordered_set<CoordsKey, KeyHash> closureSeen;
-        std::vector<Shape> closure;
-
-        while (!q.empty()) {
-            Shape s = q.front(); q.pop_front();
-            CoordsKey k = makeKey(s);
-            if (!closureSeen.insert(k).second) continue;
-            closure.push_back(s);
-
-            if (!board.isOccupied(s.getCoords(), -1, 0)) {
-                Shape t = s; t.moveLeft();
-                if (!closureSeen.count(makeKey(t))) q.push_back(t);
-            }
-            if (!board.isOccupied(s.getCoords(), +1, 0)) {
-                Shape t = s; t.moveRight(cols);
-                if (!closureSeen.count(makeKey(t))) q.push_back(t);
-            }
-            {
-                Shape t = s; t.rotateClockwise(grid, cols, rows);
-                if (!closureSeen.count(makeKey(t))) q.push_back(t);
-            }
-            {
-                Shape t = s; t.rotateCounterClockwise(grid, cols, rows);
-                if (!closureSeen.count(makeKey(t))) q.push_back(t);
-            }
-        }
-
-        std::vector<Shape> nextLayer;
-        for (auto& s : closure) {
-            if (board.isOccupied(s.getCoords(), 0, 1)) {
-                CoordsKey lk = makeKey(s);
-                if (!globallySeen.count(lk)) {
-                    globallySeen.insert(lk);
-                    locks.push_back(s);
-                }
-            } else {
-                Shape d = s; d.moveDown();
-                CoordsKey dk = makeKey(d);
-                if (globallySeen.insert(dk).second) nextLayer.push_back(d);
-            }
-        }
-        layer.swap(nextLayer);
-    }
-    return locks;
+void Game::requestMousePlan(const Shape& active, int targetGridX, int targetGridY) {
+    const bool rotateFirst = !plannedMouseLock || !plannedCoversTarget;
+    mousePlanner.submit(core.getBoard(), active, targetGridX, targetGridY, rotateFirst);
 }
 
+void Game::applyMousePlan(const AsyncPlanner::Result& result, Shape& shape) {
+    if (result.active.getType() != shape.getType()) return;
 
-int Game::scorePlacement(const Shape& locked, int targetGridX, int targetGridY) const {
-    const int rows = board.getRows(), cols = board.getCols();
-    const auto& G  = board.getGrid();
-
-    static std::vector<std::vector<int>> scratch;
-    scratch.assign(rows, std::vector<int>(cols, 0));
-    for (int r=0;r<rows;++r) for (int c=0;c<cols;++c) scratch[r][c] = (G[r][c] ? 1 : 0);
-    for (auto& p : locked.getCoords())
-        if (p.second>=0 && p.second<rows && p.first>=0 && p.first<cols) scratch[p.second][p.first] = 1;
-
-    int cleared = 0;
-    for (int r=0;r<rows;++r) {
-        bool full=true; for (int c=0;c<cols;++c) if (!scratch[r][c]) { full=false; break; }
-        if (full) ++cleared;
+    plannedMouseLock    = result.lock;
+    plannedCoversTarget = result.coversTarget;
+    if (result.rotated && !plannedCoversTarget) {
+        alignToShape(shape, result.active);
     }
-
-    int aggregate=0, holes=0, bump=0;
-    std::vector<int> h(cols,0);
-    for (int c=0;c<cols;++c){
-        for (int r=0;r<rows;++r){ if (scratch[r][c]) { h[c]=rows-r; aggregate+=h[c]; break; } }
-    }
-    for (int c=0;c<cols;++c){
-        bool seen=false;
-        for (int r=0;r<rows;++r){
-            if (scratch[r][c]) seen=true; else if (seen) ++holes;
-        }
-    }
-    for (int c=0;c<cols-1;++c) bump += std::abs(h[c]-h[c+1]);
-
-    int contacts = countContactSegments(locked, board);
-
-    int fmin=cols, fmax=-1, centreX=0, minY=rows;
-    for (auto& p : locked.getCoords()) {
-        fmin = std::min(fmin, p.first);
-        fmax = std::max(fmax, p.first);
-        centreX += p.first;
-        minY = std::min(minY, p.second);
-    }
-    centreX /= (int)locked.getCoords().size();
-
-    int rawDist = 0;
-    if (targetGridX < fmin) rawDist = fmin - targetGridX;
-    else if (targetGridX > fmax) rawDist = targetGridX - fmax;
-
-    constexpr int CONTACT_W  = 20;
-    const     int ANCHOR_W   = (int)autoPlaceAnchorW;
-    constexpr int ANCHOR_CAP = 2;
-    constexpr int FILL_BONUS = 200;
-
-    int anchorDist = std::max(0, rawDist - 1);
-    anchorDist     = std::min(anchorDist, ANCHOR_CAP);
-    int anchorPen = -ANCHOR_W * anchorDist;
-
-    bool fillsTarget = (targetGridY >= 0) && shapeCoversCell(locked, targetGridX, targetGridY);
-    int yAlignBonus  = (targetGridY >= 0) ? -std::abs(minY - targetGridY) * 5 : 0;
-
-    int score =
-          cleared      * 1000
-        + aggregate    *   -7
-        + holes        * -120
-        + bump         *   -4
-        + contacts     *  CONTACT_W
-        + anchorPen
-        + (fillsTarget ? FILL_BONUS : 0)
-        + yAlignBonus;
-
-    score -= std::max(0, std::abs(centreX - targetGridX) - 1);
-    return score;
 }
 
-void Game::planMousePlacement(int targetGridX, int targetGridY) {
+void Game::resetMousePlan() {
+    mousePlanner.cancel();
     plannedMouseLock.reset();
     plannedCoversTarget = false;
-    
-    auto locks = computeReachableLocks(currentShape);
-    if (locks.empty()) return;
-
-    int bestScore = std::numeric_limits<int>::min();
-    int bestIdx   = -1;
-    for (int i = 0; i < (int)locks.size(); ++i) {
-        int s = scorePlacement(locks[i], targetGridX, targetGridY);
-        if (s > bestScore) { 
-            bestScore = s; 
-            bestIdx = i; 
-        }
-    }
-    
-    if (bestIdx >= 0) {
-        plannedMouseLock = locks[bestIdx];
-        plannedCoversTarget = shapeCoversCell(*plannedMouseLock, targetGridX, targetGridY);
-    }
 }
 
-void Game::alignToPlannedLock() {
-    if (!plannedMouseLock) return;
+bool Game::alignToShape(Shape& shape, const Shape& target) const {
+    Shape s = target;
 
-    Shape s = *plannedMouseLock;
+    int dy = Planner::minYOf(shape) - Planner::minYOf(s);
+    s.translate(0, dy);
 
-    int dy = minYOf(currentShape) - minYOf(s);
-    for (auto& p : s.coords) p.second += dy;
+    if (core.getBoard().isOccupied(s, 0, 0)) return false;
 
-    if (board.isOccupied(s.getCoords(), 0, 0)) return;
-
-    currentShape = s;
+    shape = s;
+    return true;
 }
 
 void Game::performHardDrop() {
-    Shape placed = currentShape;
+    pendingInputs.hardDrop = true;
     if (mouseControlEnabled && plannedMouseLock.has_value() && plannedCoversTarget) {
-        placed = *plannedMouseLock;
-    } else {
-        while (!board.isOccupied(placed.getCoords(), 0, 1)) {
-            placed.moveDown();
-        }
-    }
-
-    const int dropDistance = std::max(0, minYOf(placed) - minYOf(currentShape));
-
-    board.placeShape(placed);
-    board.triggerHardDropAnim(placed);
-    if (soundEnabled) SoundManager::PlayDropSound();
-
-    const int clearedLines = board.clearFullLines();
-    updateScore(clearedLines, dropDistance, true);
-
-    if (clearedLines > 0) {
-        board.clearStartTime = SDL_GetTicks();
-    } else {
-        spawnNewShape();
+        pendingInputs.dropTarget = plannedMouseLock;
     }
-
-    lastMoveTime = SDL_GetTicks();
-    plannedMouseLock.reset();
 }
 
 bool Game::isCellReachable(int gridX, int gridY) const {
-    return board.isCellReachable(gridX, gridY);
+    return core.getBoard().isCellReachable(gridX, gridY);
 }
 
 void Game::warmupOnce() {
     if (didWarmup) return;
 
-    board.prewarm(renderer);
+    boardRenderer.prewarm(renderer);
 
     TTF_Font* f = (fontMedium ? fontMedium : fontDefault);
     if (f) {
@@ -1880,22 +1340,9 @@ void Game::warmupOnce() {
                 SDL_FreeSurface(surf);
             }
         }
-
-        const char* glyphSets[] = {"0123456789", "+-xX"};
-        for (auto s : glyphSets) {
-            if (SDL_Surface* surf = TTF_RenderText_Blended(f, s, white)) {
-                if (SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf)) SDL_DestroyTexture(tex);
-                SDL_FreeSurface(surf);
-            }
-        }
     }
 
-    if (board.whiteCellTexture) {
-        SDL_SetTextureAlphaMod(board.whiteCellTexture, 0);
-        SDL_Rect tiny{0,0,8,8};
-        SDL_RenderCopyEx(renderer, board.whiteCellTexture, nullptr, &tiny, 45.0, nullptr, SDL_FLIP_NONE);
-        SDL_SetTextureAlphaMod(board.whiteCellTexture, 255);
-    }
+    for (TTF_Font* font : {fontDefault, fontMedium, fontLarge}) textRenderer->prewarm(font);
 
     didWarmup = true;
 }
@@ -1907,7 +1354,8 @@ void Game::triggerScorePopup(int clearedLines, int linePoints) {
     const int boardOffsetX = UI::BoardOffsetX;
     const int boardOffsetY = UI::BoardOffsetY;
 
-    const float cx = boardOffsetX + board.getCols() * board.getCellSize() * 0.5f;
+    const Board& board = core.getBoard();
+    const float cx = boardOffsetX + board.getCols() * boardRenderer.getCellSize() * 0.5f;
 
     float avgRow = 0.f;
     const auto& rows = board.getLinesToClear();
@@ -1915,7 +1363,7 @@ void Game::triggerScorePopup(int clearedLines, int linePoints) {
         for (int r : rows) avgRow += r;
         avgRow /= rows.size();
     }
-    const float cy = boardOffsetY + (avgRow + 0.5f) * board.getCellSize();
+    const float cy = boardOffsetY + (avgRow + 0.5f) * boardRenderer.getCellSize();
 
     const int labelYOffset  = -12;
     const int pointsYOffset = +6;
@@ -15,9 +15,14 @@
 #include <stdexcept>
 #include <random>
 
-#include "Board.hpp"
+#include "AsyncPlanner.hpp"
+#include "BoardRenderer.hpp"
+#include "GameCore.hpp"
 #include "Shape.hpp"
+#include "ShapeRenderer.hpp"
+#include "TextRenderer.hpp"
 #include "InputHandler.hpp"
+#include "Planner.hpp"
 #include "SDLFormUI.hpp"
 #include "SoundManager.hpp"
 
@@ -90,15 +95,13 @@ private:
     };
 
     void processInput();
+    void handleRenderReset(const SDL_Event& e);
     void update();
     void render();
 
-    void spawnNewShape();
     bool isGameOver() const noexcept;
 
-    void autoRotateCurrentShape(int targetGridX, int targetGridY = -1);
-    void snapShapeHorizontally(int targetGridX);
-    int  countContactSegments(const Shape& shape, const Board& board) const;
+    void snapShapeHorizontally(Shape& shape, int targetGridX);
 
     void renderNextPieces();
     void renderHoldPiece();
@@ -111,11 +114,8 @@ private:
     void renderTextCenteredScaled(const std::string& text, int cx, int cy,
                                   SDL_Color color, float scale, TTF_Font* useFont);
 
-    void   checkLevelUp();
-    void   updateScore(int clearedLines, int dropDistance, bool hardDrop);
-    void   updateSpeed();
     void   resetGame();
-    void   holdPiece();
+    void   handleCoreEvents(const GameCore::Events& events);
     Uint32 getElapsedGameTime() const noexcept;
 
     bool didWarmup = false;
@@ -136,30 +136,24 @@ private:
     SDL_Renderer* renderer          = nullptr;
     SDL_Texture*  backgroundTexture = nullptr;
 
+    std::unique_ptr<TextRenderer> textRenderer;
+
     TTF_Font* fontLarge   = nullptr;
     TTF_Font* fontMedium  = nullptr;
     TTF_Font* fontSmall   = nullptr;
     TTF_Font* fontDefault = nullptr;
 
-    Board                   board;
-    Shape                   currentShape;
-    Shape                   shadowShape;
-    std::optional<Shape>    heldShape  = std::nullopt;
-    std::deque<Shape>       nextPieces;
-    bool                    canHold    = true;
-
-    int  score             = 0;
-    int  level             = 1;
-    int  totalLinesCleared = 0;
-
-    int lastMouseTargetGridX = std::numeric_limits<int>::min();
-    int lastMouseTargetGridY = std::numeric_limits<int>::min();
+    GameCore         core;
+    BoardRenderer    boardRenderer;
+    Shape            shadowShape;
+    Shape            ghostSource;
+    uint64_t         ghostBoardHash = 0;
+    GameCore::Inputs pendingInputs;
 
     int    cellSize;
     int    windowWidth;
     int    windowHeight;
-    int    speed                 = 800;
-    Uint32 lastMoveTime          = 0;
+    Uint32 lastStepTime          = 0;
     Uint32 lastHorizontalMoveTime= 0;
     Uint32 lastDownMoveTime      = 0;
     Uint32 lastRotationTime      = 0;
@@ -187,11 +181,9 @@ private:
     bool   mouseControlEnabled        = true;
     Screen currentScreen              = Screen::Main;
 
-    int   autoPlaceWindow     = 2;
     int   mouseMagnetRadius   = 0;
     float mouseFollowStrength = 0.35f;
     float mouseXAccumulator   = 0.0f;
-    float autoPlaceAnchorW    = 2.0f;
 
     InputHandler inputHandler;
 
@@ -238,13 +230,15 @@ private:
     
     bool mouseMovedThisFrame = false;
 
-    std::vector<Shape> computeReachableLocks(const Shape& start) const;
-    void               planMousePlacement(int targetGridX, int targetGridY);
-    int                scorePlacement(const Shape& locked, int targetGridX, int targetGridY) const;
+    WorkerPool   plannerPool;
+    Planner      planner;
+    AsyncPlanner mousePlanner;
+    Uint32       lastPlanRequestTime = 0;
 
-    static int   minYOf(const Shape& s) noexcept;
-    static bool  shapeCoversCell(const Shape& s, int gx, int gy) noexcept;
-    void         alignToPlannedLock();
+    void         requestMousePlan(const Shape& active, int targetGridX, int targetGridY);
+    void         applyMousePlan(const AsyncPlanner::Result& result, Shape& shape);
+    void         resetMousePlan();
+    bool         alignToShape(Shape& shape, const Shape& target) const;
     void         performHardDrop();
 
     bool isCellReachable(int gridX, int gridY) const;
@@ -265,5 +259,4 @@ private:
             return sOver + (sEnd - sOver) * easeInOutQuad(p);
         }
     }
-    std::mt19937 rng;
 };
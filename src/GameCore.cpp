@@ -0,0 +1,218 @@
+#include "GameCore.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+GameCore::GameCore(int rows, int cols, uint32_t seed)
+    : board(rows, cols),
+      currentShape(Shape::Type::O, cols / 2, 0),
+      rng(seed) {
+    spawnNewShape();
+}
+
+void GameCore::reset() {
+    board.clearBoard();
+    score = totalLinesCleared = 0;
+    level = 1;
+    nextPieces.clear();
+    canHold = true;
+    heldShape.reset();
+    gravityElapsed = lineClearElapsed = 0;
+    spawnNewShape();
+}
+
+GameCore::Events GameCore::step(const Inputs& inputs, uint32_t dtMs) {
+    Events events;
+    if (isGameOver()) return events;
+
+    gravityElapsed += dtMs;
+
+    if (board.isClearingLines) {
+        lineClearElapsed += dtMs;
+        if (lineClearElapsed >= LineClearDelayMs) {
+            board.finalizeLineClear();
+            spawnNewShape();
+            events.spawned = true;
+        }
+        return events;
+    }
+
+    if (inputs.moveTo && !board.isOccupied(*inputs.moveTo, 0, 0)) {
+        currentShape = *inputs.moveTo;
+    }
+
+    const int dir = inputs.shift < 0 ? -1 : 1;
+    for (int i = 0; i < std::abs(inputs.shift); ++i) {
+        if (board.isOccupied(currentShape, dir, 0)) break;
+        if (dir < 0) currentShape.moveLeft();
+        else         currentShape.moveRight(board.getCols());
+        events.moved = true;
+    }
+
+    for (int i = 0; i < inputs.rotation; ++i)  currentShape.rotateClockwise(board.getPlayfield());
+    for (int i = 0; i < -inputs.rotation; ++i) currentShape.rotateCounterClockwise(board.getPlayfield());
+
+    if (inputs.softDrop && !board.isOccupied(currentShape, 0, 1)) {
+        currentShape.moveDown();
+        events.moved = true;
+        updateScore(0, 1, false, events);
+    }
+
+    if (inputs.hardDrop) {
+        hardDrop(inputs.dropTarget, events);
+        return events;
+    }
+
+    if (inputs.hold && canHold) {
+        holdPiece();
+        events.held = true;
+    }
+
+    if (gravityElapsed >= static_cast<uint32_t>(speed)) {
+        if (!board.isOccupied(currentShape, 0, 1)) {
+            currentShape.moveDown();
+            events.moved = true;
+        } else {
+            lockShape(currentShape, 0, false, events);
+        }
+        gravityElapsed = 0;
+    }
+    return events;
+}
+
+float GameCore::getLineClearProgress() const noexcept {
+    if (!board.isClearingLines) return 0.0f;
+    return std::min(lineClearElapsed / float(LineClearDelayMs), 1.0f);
+}
+
+bool GameCore::isGameOver() const noexcept {
+    if (board.isClearingLines) return false;
+    return board.isOccupied(currentShape, 0, 0);
+}
+
+Shape GameCore::randomShape() {
+    std::uniform_int_distribution<int> dist(0, Shape::TypeCount - 1);
+    return Shape(static_cast<Shape::Type>(dist(rng)), board.getCols() / 2, 0);
+}
+
+void GameCore::spawnNewShape() {
+    if (nextPieces.empty()) {
+        for (int i = 0; i < PreviewCount; i++) {
+            nextPieces.push_back(randomShape());
+        }
+    }
+
+    currentShape = nextPieces.front();
+    nextPieces.pop_front();
+
+    if (isGameOver()) {
+        return;
+    }
+
+    nextPieces.push_back(randomShape());
+    canHold = true;
+}
+
+void GameCore::holdPiece() {
+    Shape::Type currentType = currentShape.getType();
+
+    if (heldShape.has_value()) {
+        Shape::Type heldType = heldShape->getType();
+
+        heldShape = Shape(currentType, 0, 0);
+        currentShape = Shape(heldType, board.getCols() / 2, 0);
+    } else {
+        heldShape = Shape(currentType, 0, 0);
+        spawnNewShape();
+    }
+
+    canHold = false;
+}
+
+void GameCore::hardDrop(const std::optional<Shape>& target, Events& events) {
+    Shape placed = currentShape;
+    if (target && !board.isOccupied(*target, 0, 0)) {
+        placed = *target;
+    } else {
+        placed.translate(0, board.dropDistance(placed));
+    }
+
+    const int dropDistance = std::max(0, minYOf(placed) - minYOf(currentShape));
+    events.hardDropped = true;
+    lockShape(placed, dropDistance, true, events);
+    gravityElapsed = 0;
+}
+
+void GameCore::lockShape(const Shape& placed, int dropDistance, bool hardDrop, Events& events) {
+    board.placeShape(placed);
+    events.locked = placed;
+
+    const int clearedLines = board.clearFullLines();
+    updateScore(clearedLines, dropDistance, hardDrop, events);
+
+    if (clearedLines > 0) {
+        lineClearElapsed = 0;
+    } else {
+        spawnNewShape();
+        events.spawned = true;
+    }
+}
+
+void GameCore::updateScore(int clearedLines, int dropDistance, bool hardDrop, Events& events) {
+    if (clearedLines > 0) {
+        totalLinesCleared += clearedLines;
+    }
+
+    int points = 0;
+    switch (clearedLines) {
+        case 1: points += 40;   break;
+        case 2: points += 100;  break;
+        case 3: points += 300;  break;
+        case 4: points += 1200; break;
+    }
+    points *= (level + 1);
+    points += dropDistance * (hardDrop ? 2 : 1);
+    score  += points;
+
+    if (clearedLines > 0) {
+        events.clearedLines = clearedLines;
+        events.points       = points;
+    }
+
+    checkLevelUp(events);
+}
+
+void GameCore::checkLevelUp(Events& events) {
+    int newLevel = (totalLinesCleared / 10) + 1;
+
+    if (newLevel > level) {
+        level = newLevel;
+        updateSpeed();
+        events.levelUp = true;
+    }
+}
+
+void GameCore::updateSpeed() {
+    if (level == 0) speed = 800;
+    else if (level == 1) speed = 717;
+    else if (level == 2) speed = 633;
+    else if (level == 3) speed = 550;
+    else if (level == 4) speed = 467;
+    else if (level == 5) speed = 383;
+    else if (level == 6) speed = 300;
+    else if (level == 7) speed = 217;
+    else if (level == 8) speed = 133;
+    else if (level == 9) speed = 100;
+    else if (level >= 10 && level <= 12) speed = 83;
+    else if (level >= 13 && level <= 15) speed = 67;
+    else if (level >= 16 && level <= 18) speed = 50;
+    else if (level >= 19 && level <= 28) speed = 33;
+    else speed = 16;
+}
+
+int GameCore::minYOf(const Shape& s) noexcept {
+    int my = INT_MAX;
+    for (auto& c : s.getCoords()) my = std::min(my, c.second);
+    return (my == INT_MAX) ? 0 : my;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <random>
+
+#include "Board.hpp"
+#include "Shape.hpp"
+
+// Game rules with no platform dependencies: a frontend feeds it inputs and
+// elapsed time, and reacts to the events each step reports.
+class GameCore {
+public:
+    static constexpr uint32_t LineClearDelayMs = 500;
+    static constexpr int      PreviewCount     = 3;
+
+    struct Inputs {
+        std::optional<Shape> moveTo;     // reposition the active piece; ignored if obstructed
+        int  shift    = 0;               // columns, negative is left
+        int  rotation = 0;               // quarter turns, negative is counter-clockwise
+        bool softDrop = false;
+        bool hardDrop = false;
+        std::optional<Shape> dropTarget; // lock to hard-drop into instead of straight down
+        bool hold     = false;
+    };
+
+    struct Events {
+        bool moved        = false;
+        bool held         = false;
+        bool hardDropped  = false;
+        bool spawned      = false;
+        bool levelUp      = false;
+        int  clearedLines = 0;
+        int  points       = 0;
+        std::optional<Shape> locked;
+    };
+
+    GameCore(int rows, int cols, uint32_t seed);
+
+    Events step(const Inputs& inputs, uint32_t dtMs);
+    void   reset();
+
+    const Board&                getBoard() const noexcept        { return board; }
+    const Shape&                getCurrentShape() const noexcept { return currentShape; }
+    const std::optional<Shape>& getHeldShape() const noexcept    { return heldShape; }
+    const std::deque<Shape>&    getNextPieces() const noexcept   { return nextPieces; }
+
+    bool  canHoldPiece() const noexcept         { return canHold; }
+    int   getScore() const noexcept             { return score; }
+    int   getLevel() const noexcept             { return level; }
+    int   getTotalLinesCleared() const noexcept { return totalLinesCleared; }
+    int   getSpeed() const noexcept             { return speed; }
+    float getLineClearProgress() const noexcept;
+    bool  isGameOver() const noexcept;
+
+private:
+    Board                board;
+    Shape                currentShape;
+    std::optional<Shape> heldShape = std::nullopt;
+    std::deque<Shape>    nextPieces;
+    bool                 canHold   = true;
+
+    int score             = 0;
+    int level             = 1;
+    int totalLinesCleared = 0;
+    int speed             = 800;
+
+    uint32_t gravityElapsed   = 0;
+    uint32_t lineClearElapsed = 0;
+
+    std::mt19937 rng;
+
+    Shape randomShape();
+    void  spawnNewShape();
+    void  holdPiece();
+    void  hardDrop(const std::optional<Shape>& target, Events& events);
+    void  lockShape(const Shape& placed, int dropDistance, bool hardDrop, Events& events);
+    void  updateScore(int clearedLines, int dropDistance, bool hardDrop, Events& events);
+    void  checkLevelUp(Events& events);
+    void  updateSpeed();
+
+    static int minYOf(const Shape& s) noexcept;
+};
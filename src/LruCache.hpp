@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// Bounded map that evicts the least recently used entry. A capacity of
+// zero disables it: find() always misses and insert() stores nothing.
+template <class Key, class Value, class Hash = std::hash<Key>>
+class LruCache {
+public:
+    explicit LruCache(size_t capacity = 0) : limit(capacity) {}
+
+    size_t capacity() const noexcept { return limit; }
+    size_t size() const noexcept     { return index.size(); }
+
+    void setCapacity(size_t capacity) {
+        limit = capacity;
+        while (index.size() > limit) evictOldest();
+    }
+
+    void clear() {
+        index.clear();
+        entries.clear();
+    }
+
+    // Returns the cached value and marks it most recently used.
+    const Value* find(const Key& key) {
+        auto it = index.find(key);
+        if (it == index.end()) return nullptr;
+        entries.splice(entries.begin(), entries, it->second);
+        return &it->second->second;
+    }
+
+    void insert(const Key& key, const Value& value) {
+        if (limit == 0) return;
+        if (auto it = index.find(key); it != index.end()) {
+            it->second->second = value;
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+        if (index.size() >= limit) {
+            // Recycle the oldest node rather than allocating a new one.
+            auto oldest = std::prev(entries.end());
+            index.erase(oldest->first);
+            oldest->first  = key;
+            oldest->second = value;
+            entries.splice(entries.begin(), entries, oldest);
+        } else {
+            entries.emplace_front(key, value);
+        }
+        index.emplace(key, entries.begin());
+    }
+
+private:
+    using Entry = std::pair<Key, Value>;
+
+    size_t                                                           limit;
+    std::list<Entry>                                                 entries;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index;
+
+    void evictOldest() {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+};
@@ -0,0 +1,252 @@
+#include "PixelCanvas.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// The per-pixel loops are written so GCC vectorizes them: selects instead
+// of branches, int rather than unsigned conversions. The Makefile adds
+// PIXELCANVAS_FLAGS for this file so sqrt is one instruction, float selects
+// can be if-converted and loops of unknown length are worth vectorizing;
+// check with -fopt-info-vec.
+namespace {
+inline float maxf(float a, float b) noexcept { return a > b ? a : b; }
+inline float minf(float a, float b) noexcept { return a < b ? a : b; }
+inline float clamp01(float v) noexcept { return minf(maxf(v, 0.0f), 1.0f); }
+
+inline uint32_t pack(int r, int g, int b, int a) noexcept {
+    return uint32_t(a) << 24 | uint32_t(r) << 16 | uint32_t(g) << 8 | uint32_t(b);
+}
+
+// Distance past the corner centres along one axis, measured from pixel
+// centres. Zero along the straight edges and in the middle.
+inline float edgeDistance(float p, float lo, float hi) noexcept {
+    return maxf(0.0f, maxf(lo - p, p - hi));
+}
+}
+
+PixelCanvas::PixelCanvas(int width, int height)
+    : width(std::max(0, width)), height(std::max(0, height)),
+      pixels(size_t(this->width) * this->height, 0),
+      coverage(this->width), edgeX(this->width), source(this->width) {}
+
+void PixelCanvas::clear() {
+    std::fill(pixels.begin(), pixels.end(), 0u);
+}
+
+PixelCanvas::Span PixelCanvas::clip(int x, int y, int w, int h) const {
+    Span s;
+    s.x0 = std::max(x, 0);
+    s.y0 = std::max(y, 0);
+    s.x1 = std::min(x + w, width);
+    s.y1 = std::min(y + h, height);
+    return s;
+}
+
+void PixelCanvas::roundedRectEdgeX(const Span& span, int x, int w, int radius) {
+    const float lo = float(x + radius);
+    const float hi = float(x + w - radius);
+    const int count = span.x1 - span.x0;
+    float*    ex    = edgeX.data();
+    for (int i = 0; i < count; ++i) {
+        const float d = edgeDistance(float(span.x0 + i) + 0.5f, lo, hi);
+        ex[i] = d * d;
+    }
+}
+
+float PixelCanvas::roundedRectEdgeY(int py, int y, int h, int radius) {
+    const float d = edgeDistance(float(py) + 0.5f, float(y + radius), float(y + h - radius));
+    return d * d;
+}
+
+void PixelCanvas::compositeCoverage(int x0, int y, int count, SDL_Color color) {
+    const float* cov = coverage.data();
+    uint32_t*    src = source.data();
+    const uint32_t rgb   = pack(color.r, color.g, color.b, 0);
+    const float    alpha = float(color.a);
+    for (int i = 0; i < count; ++i) {
+        src[i] = rgb | uint32_t(int(alpha * cov[i])) << 24;
+    }
+    compositeSource(x0, y, count);
+}
+
+void PixelCanvas::compositeSource(int x0, int y, int count) {
+    const uint32_t* src = source.data();
+    uint32_t*       dst = pixels.data() + size_t(y) * width + x0;
+    for (int i = 0; i < count; ++i) {
+        const uint32_t s  = src[i];
+        const uint32_t d  = dst[i];
+        const float    sa = float(int(s >> 24)) * (1.0f / 255.0f);
+        const float    da = float(int(d >> 24)) * (1.0f / 255.0f) * (1.0f - sa);
+        const float    oa = sa + da;
+        // Where both alphas are zero the colour sums are zero too, so any
+        // finite k gives transparent black.
+        const float    k  = 1.0f / maxf(oa, 1e-6f);
+        const float    r  = (float(int((s >> 16) & 0xFF)) * sa + float(int((d >> 16) & 0xFF)) * da) * k;
+        const float    g  = (float(int((s >> 8) & 0xFF)) * sa + float(int((d >> 8) & 0xFF)) * da) * k;
+        const float    b  = (float(int(s & 0xFF)) * sa + float(int(d & 0xFF)) * da) * k;
+        dst[i] = pack(int(r + 0.5f), int(g + 0.5f), int(b + 0.5f), int(oa * 255.0f + 0.5f));
+    }
+}
+
+void PixelCanvas::fillRoundedRect(int x, int y, int w, int h, int radius, SDL_Color color) {
+    const Span span = clip(x, y, w, h);
+    if (span.empty()) return;
+    roundedRectEdgeX(span, x, w, radius);
+
+    const int    count = span.x1 - span.x0;
+    const float  outer = radius + 0.5f;
+    const float* ex    = edgeX.data();
+    float*       cov   = coverage.data();
+    for (int py = span.y0; py < span.y1; ++py) {
+        const float ey = roundedRectEdgeY(py, y, h, radius);
+        for (int i = 0; i < count; ++i) {
+            cov[i] = clamp01(outer - std::sqrt(ex[i] + ey));
+        }
+        compositeCoverage(span.x0, py, count, color);
+    }
+}
+
+void PixelCanvas::strokeRoundedRect(int x, int y, int w, int h, int radius, int thickness, SDL_Color color) {
+    const Span span = clip(x, y, w, h);
+    if (span.empty() || thickness <= 0) return;
+    roundedRectEdgeX(span, x, w, radius);
+
+    const int    count = span.x1 - span.x0;
+    const float  outer = radius + 0.5f;
+    const float  inner = float(radius - thickness);
+    const float* ex    = edgeX.data();
+    float*       cov   = coverage.data();
+    for (int py = span.y0; py < span.y1; ++py) {
+        const float ey = roundedRectEdgeY(py, y, h, radius);
+        for (int i = 0; i < count; ++i) {
+            const float d = std::sqrt(ex[i] + ey);
+            cov[i] = (d >= inner && d <= outer) ? 1.0f : 0.0f;
+        }
+        compositeCoverage(span.x0, py, count, color);
+    }
+}
+
+void PixelCanvas::drawRoundedRectBorder(int x, int y, int w, int h, int radius, int thickness, SDL_Color color) {
+    const Span span = clip(x, y, w, h);
+    if (span.empty() || thickness <= 0) return;
+    roundedRectEdgeX(span, x, w, radius);
+
+    const int    count = span.x1 - span.x0;
+    const float  outer = radius + 0.5f;
+    const float  inner = radius - thickness - 0.5f;
+    const float* ex    = edgeX.data();
+    float*       cov   = coverage.data();
+    for (int py = span.y0; py < span.y1; ++py) {
+        const float ey = roundedRectEdgeY(py, y, h, radius);
+        for (int i = 0; i < count; ++i) {
+            const float d = std::sqrt(ex[i] + ey);
+            cov[i] = clamp01(outer - d) * clamp01(d - inner);
+        }
+        compositeCoverage(span.x0, py, count, color);
+    }
+}
+
+void PixelCanvas::fillGradientRoundedRect(int x, int y, int w, int h, int radius, SDL_Color color) {
+    const Span span = clip(x, y, w, h);
+    if (span.empty()) return;
+    roundedRectEdgeX(span, x, w, radius);
+
+    const float startR = float(255 - (255 - color.r) / 2);
+    const float startG = float(255 - (255 - color.g) / 2);
+    const float startB = float(255 - (255 - color.b) / 2);
+    const float endR = color.r, endG = color.g, endB = color.b;
+    const float centerX     = float(x + w / 2);
+    const float centerY     = float(y + h);
+    const float maxDistance = std::sqrt((w / 2.0f) * (w / 2.0f) + float(h) * h);
+    const float invMax      = maxDistance > 0.0f ? 1.0f / maxDistance : 0.0f;
+
+    const int    count = span.x1 - span.x0;
+    const float  outer = radius + 0.5f;
+    const float* ex    = edgeX.data();
+    uint32_t*    src   = source.data();
+    for (int py = span.y0; py < span.y1; ++py) {
+        const float ey = roundedRectEdgeY(py, y, h, radius);
+        const float dy = float(py) - centerY;
+        for (int i = 0; i < count; ++i) {
+            const float alpha = clamp01(outer - std::sqrt(ex[i] + ey));
+            const float dx    = float(span.x0 + i) - centerX;
+            const float t     = minf(std::sqrt(dx * dx + dy * dy) * invMax, 1.0f);
+            src[i] = pack(int(startR * (1.0f - t) + endR * t),
+                          int(startG * (1.0f - t) + endG * t),
+                          int(startB * (1.0f - t) + endB * t),
+                          int(255.0f * alpha));
+        }
+        compositeSource(span.x0, py, count);
+    }
+}
+
+void PixelCanvas::fillCircle(int cx, int cy, int radius, SDL_Color color) {
+    if (radius <= 0) return;
+    const Span span = clip(cx - radius, cy - radius, 2 * radius + 1, 2 * radius + 1);
+    if (span.empty()) return;
+
+    const int count = span.x1 - span.x0;
+    float*    ex    = edgeX.data();
+    float*    cov   = coverage.data();
+    for (int i = 0; i < count; ++i) {
+        const float dx = float(span.x0 + i - cx);
+        ex[i] = dx * dx;
+    }
+    for (int py = span.y0; py < span.y1; ++py) {
+        const float dy = float(py - cy);
+        for (int i = 0; i < count; ++i) {
+            cov[i] = clamp01(float(radius) - std::sqrt(ex[i] + dy * dy));
+        }
+        compositeCoverage(span.x0, py, count, color);
+    }
+}
+
+void PixelCanvas::drawHighlightArc(int x, int y, int w, int h, int margin, int borderThickness) {
+    const int gradX = x + margin + borderThickness;
+    const int gradY = y + margin + borderThickness;
+    const int gradW = w - 2 * (margin + borderThickness);
+    const int gradH = h - 2 * (margin + borderThickness);
+    if (gradW <= 0 || gradH <= 0) return;
+
+    // A parabola of half-width gradW/2 at the top narrowing to nothing a
+    // quarter of the way down, drawn as a white band `thickness` wide on
+    // either side and faded out over a pixel at the top and bottom.
+    const int   topY      = gradY;
+    const int   bottomY   = gradY + gradH / 4;
+    const float centerX   = float(gradX + gradW / 2);
+    const float thickness = float(std::max(2, gradH / 18));
+    if (bottomY <= topY) return;
+
+    const SDL_Color white{255, 255, 255, 128};
+
+    float* cov = coverage.data();
+    for (int py = std::max(topY, 0); py <= bottomY && py < height; ++py) {
+        const float t         = float(py - topY) / float(bottomY - topY);
+        const float halfWidth = (gradW / 2.0f) * (1.0f - t * t);
+        const float centerY   = py + 0.5f;
+        const float vFade     = std::clamp(std::min(centerY - topY, bottomY - centerY), 0.0f, 1.0f);
+
+        const int x0 = std::max(0, int(centerX - halfWidth - thickness));
+        const int x1 = std::min(width, int(centerX + halfWidth + thickness) + 1);
+        if (x0 >= x1) continue;
+        const int count = x1 - x0;
+        for (int i = 0; i < count; ++i) {
+            const float dist = maxf(0.0f, std::fabs(float(x0 + i) + 0.5f - centerX) - halfWidth);
+            cov[i] = clamp01(thickness - dist) * vFade;
+        }
+        compositeCoverage(x0, py, count, white);
+    }
+}
+
+SDL_Texture* PixelCanvas::createTexture(SDL_Renderer* renderer) const {
+    if (width == 0 || height == 0) return nullptr;
+    SDL_Texture* tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                         width, height);
+    if (!tex) {
+        SDL_Log("Failed to create canvas texture: %s", SDL_GetError());
+        return nullptr;
+    }
+    SDL_UpdateTexture(tex, nullptr, pixels.data(), width * int(sizeof(uint32_t)));
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    return tex;
+}
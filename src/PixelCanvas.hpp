@@ -0,0 +1,59 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+// CPU-side RGBA image for the anti-aliased DrawUtils primitives. Shapes are
+// rasterized a row at a time (coverage first, then compositing) and reach the
+// GPU in one texture upload instead of one draw call per pixel.
+//
+// Pixels are straight-alpha ARGB8888 and every draw composites "source over",
+// so drawing onto a cleared canvas and copying it with SDL_BLENDMODE_BLEND
+// looks the same as drawing the shapes onto the target one after another.
+// Coordinates are canvas pixels; anything outside the canvas is clipped.
+class PixelCanvas {
+public:
+    PixelCanvas(int width, int height);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const uint32_t* getPixels() const { return pixels.data(); }
+
+    void clear();
+
+    void fillRoundedRect(int x, int y, int w, int h, int radius, SDL_Color color);
+    // Hard-edged outline `thickness` pixels wide, inside the rect.
+    void strokeRoundedRect(int x, int y, int w, int h, int radius, int thickness, SDL_Color color);
+    // Anti-aliased on both the outer and the inner edge.
+    void drawRoundedRectBorder(int x, int y, int w, int h, int radius, int thickness, SDL_Color color);
+    // Radial gradient from a lightened `color` at the bottom centre out to `color`.
+    void fillGradientRoundedRect(int x, int y, int w, int h, int radius, SDL_Color color);
+    void fillCircle(int cx, int cy, int radius, SDL_Color color);
+    // The glossy arc across the top of a block face; see draw_smooth_parabolic_highlight_arc.
+    void drawHighlightArc(int x, int y, int w, int h, int margin, int borderThickness);
+
+    // Static texture holding the canvas, with blending enabled. Caller owns it.
+    SDL_Texture* createTexture(SDL_Renderer* renderer) const;
+
+private:
+    struct Span {
+        int x0 = 0, x1 = 0, y0 = 0, y1 = 0;
+        bool empty() const { return x0 >= x1 || y0 >= y1; }
+    };
+
+    int                   width;
+    int                   height;
+    std::vector<uint32_t> pixels;
+    std::vector<float>    coverage;   // one row of scratch
+    std::vector<float>    edgeX;      // squared horizontal distance to the rounded corner centres
+    std::vector<uint32_t> source;     // one row of colours waiting to be composited
+
+    Span clip(int x, int y, int w, int h) const;
+    // Fills edgeX for columns [x0, x1) and returns the squared vertical
+    // distance for row py, for a rounded rect with corner centres inset by radius.
+    void roundedRectEdgeX(const Span& span, int x, int w, int radius);
+    static float roundedRectEdgeY(int py, int y, int h, int radius);
+
+    void compositeCoverage(int x0, int y, int count, SDL_Color color);
+    void compositeSource(int x0, int y, int count);
+};
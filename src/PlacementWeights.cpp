@@ -0,0 +1,93 @@
+#include "PlacementWeights.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+struct Field {
+    const char*            name;
+    int PlacementWeights::* member;
+};
+
+const Field fields[PlacementWeights::Count] = {
+    {"lines",             &PlacementWeights::lines},
+    {"contacts",          &PlacementWeights::contacts},
+    {"aggregate_height",  &PlacementWeights::aggregateHeight},
+    {"holes",             &PlacementWeights::holes},
+    {"bumpiness",         &PlacementWeights::bumpiness},
+    {"fill_bonus",        &PlacementWeights::fillBonus},
+    {"anchor_cap",        &PlacementWeights::anchorCap},
+    {"row_align",         &PlacementWeights::rowAlign},
+    {"rotate_stability",  &PlacementWeights::rotateStability},
+    {"rotate_fill_bonus", &PlacementWeights::rotateFillBonus},
+};
+
+const Field& fieldAt(int index) {
+    if (index < 0 || index >= PlacementWeights::Count)
+        throw std::invalid_argument("weight index out of range");
+    return fields[index];
+}
+} // namespace
+
+const char* PlacementWeights::name(int index) {
+    return fieldAt(index).name;
+}
+
+int& PlacementWeights::operator[](int index) {
+    return this->*fieldAt(index).member;
+}
+
+int PlacementWeights::operator[](int index) const {
+    return this->*fieldAt(index).member;
+}
+
+bool PlacementWeights::operator==(const PlacementWeights& o) const noexcept {
+    for (const Field& f : fields)
+        if (this->*f.member != o.*f.member) return false;
+    return true;
+}
+
+PlacementWeights PlacementWeights::load(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Failed to open weights file: " + path);
+
+    PlacementWeights weights;
+    std::string line;
+    for (int lineNo = 1; std::getline(in, line); ++lineNo) {
+        line = line.substr(0, line.find('#'));
+        std::istringstream fieldsIn(line);
+        std::string key;
+        if (!(fieldsIn >> key)) continue;
+
+        const Field* field = nullptr;
+        for (const Field& f : fields)
+            if (key == f.name) field = &f;
+        long value = 0;
+        std::string rest;
+        if (!field || !(fieldsIn >> value) || (fieldsIn >> rest) ||
+            value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+            throw std::runtime_error(path + ":" + std::to_string(lineNo) + ": bad weight line");
+        weights.*field->member = int(value);
+    }
+    return weights;
+}
+
+void PlacementWeights::save(const std::string& path) const {
+    // Write to a temporary file first so a crash never leaves half a file.
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp);
+        if (!out) throw std::runtime_error("Failed to write weights file: " + tmp);
+        for (const Field& f : fields) out << f.name << ' ' << this->*f.member << '\n';
+        if (!out) throw std::runtime_error("Failed to write weights file: " + tmp);
+    }
+    // std::filesystem::rename replaces an existing file on Windows too,
+    // where std::rename fails once the destination exists.
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec)
+        throw std::runtime_error("Failed to replace weights file: " + path);
+}
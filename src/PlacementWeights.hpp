@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+
+// Weights of the placement heuristic. Stored as a plain text file with one
+// "name value" pair per line; '#' starts a comment and names that are left
+// out keep their defaults.
+struct PlacementWeights {
+    // Board shape after a lock; every search uses these.
+    int lines           = 1000;
+    int contacts        = 20;
+    int aggregateHeight = -7;
+    int holes           = -120;
+    int bumpiness       = -4;
+
+    // Mouse target terms.
+    int fillBonus = 200;
+    int anchorCap = 2;
+    int rowAlign  = 5;
+
+    // Auto-rotation towards the mouse target.
+    int rotateStability = 15;
+    int rotateFillBonus = 1'000'000;
+
+    static constexpr int Count     = 10;
+    static constexpr int LockCount = 5;   // the first LockCount entries are the lock terms
+
+    static const char* name(int index);
+    int& operator[](int index);
+    int  operator[](int index) const;
+
+    bool operator==(const PlacementWeights& o) const noexcept;
+    bool operator!=(const PlacementWeights& o) const noexcept { return !(*this == o); }
+
+    static PlacementWeights load(const std::string& path);
+    void save(const std::string& path) const;
+};
@@ -0,0 +1,516 @@
+#include "Planner.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <limits>
+
+int Planner::minYOf(const Shape& s) noexcept {
+    int my = INT_MAX;
+    for (auto& c : s.getCoords()) my = std::min(my, c.second);
+    return (my == INT_MAX) ? 0 : my;
+}
+bool Planner::shapeCoversCell(const Shape& s, int gx, int gy) noexcept {
+    for (auto& c : s.getCoords()) if (c.first == gx && c.second == gy) return true;
+    return false;
+}
+
+void Planner::computeReachableLocks(const Board& board, const Shape& start, std::vector<Shape>& locks) const {
+    // States are (rotation, origin x) within one drop layer; every move but
+    // the drop stays in the layer, so each layer is closed with a small
+    // bounded queue before its unsupported states fall into the next one.
+    constexpr int PadX          = 6;
+    constexpr int PadY          = 5;
+    constexpr int Stride        = Playfield::MaxCols + 2 * PadX;
+    constexpr int LayerCapacity = 4 * Stride;
+    static_assert(LayerCapacity <= 256, "layer state ids must fit in a byte");
+    static_assert(Stride <= 64, "one visited word per rotation");
+
+    const Playfield& field = board.getPlayfield();
+    const int cols      = board.getCols();
+    const int y0        = start.getOriginY();
+    const int layerSpan = board.getRows() - y0 + 2 * PadY;
+
+    locks.clear();
+    lockSeenScratch.assign((size_t(std::max(layerSpan, 1)) * LayerCapacity + 63) / 64, 0);
+
+    std::array<uint8_t, LayerCapacity> layer{}, next{};
+    std::array<uint64_t, 4>            seen{}, nextSeen{};
+    int layerSize = 0;
+    int y         = y0;
+
+    auto idOf = [](const Shape& s) { return s.getRotation() * Stride + s.getOriginX() + PadX; };
+    auto stateOf = [&](int id) {
+        Shape s = start;
+        s.setRotation(id / Stride);
+        s.setPosition(id % Stride - PadX, y);
+        return s;
+    };
+    auto push = [&](const Shape& s) {
+        const int      id  = idOf(s);
+        const uint64_t bit = uint64_t(1) << (id % Stride);
+        if (seen[id / Stride] & bit) return;
+        seen[id / Stride] |= bit;
+        layer[layerSize++] = static_cast<uint8_t>(id);
+    };
+
+    push(start);
+    while (layerSize > 0) {
+        for (int head = 0; head < layerSize; ++head) {
+            const Shape s = stateOf(layer[head]);
+
+            if (!field.isOccupied(s, -1, 0)) { Shape t = s; t.moveLeft();                  push(t); }
+            if (!field.isOccupied(s, +1, 0)) { Shape t = s; t.moveRight(cols);             push(t); }
+            {                                  Shape t = s; t.rotateClockwise(field);        push(t); }
+            {                                  Shape t = s; t.rotateCounterClockwise(field); push(t); }
+        }
+
+        int nextSize = 0;
+        nextSeen = {};
+        for (int i = 0; i < layerSize; ++i) {
+            const int id = layer[i];
+            const Shape s = stateOf(id);
+            if (field.isOccupied(s, 0, 1)) {
+                const Shape  c   = s.canonical();
+                const size_t bit = (size_t(c.getOriginY() - y0 + PadY) * 4 + c.getRotation()) * Stride
+                                 + size_t(c.getOriginX() + PadX);
+                uint64_t& word = lockSeenScratch[bit / 64];
+                const uint64_t mask = uint64_t(1) << (bit % 64);
+                if (!(word & mask)) {
+                    word |= mask;
+                    locks.push_back(s);
+                }
+            } else {
+                nextSeen[id / Stride] |= uint64_t(1) << (id % Stride);
+                next[nextSize++] = static_cast<uint8_t>(id);
+            }
+        }
+
+        layer.swap(next);
+        seen      = nextSeen;
+        layerSize = nextSize;
+        ++y;
+    }
+}
+
+// Terms earned by the move itself, as opposed to the shape it leaves.
+int Planner::moveScore(const Features& f) const noexcept {
+    return f.clearedLines * weights.lines
+         + f.contacts     * weights.contacts;
+}
+
+int Planner::lockScore(const Features& f) const noexcept {
+    return moveScore(f)
+         + f.aggregateHeight * weights.aggregateHeight
+         + f.holes           * weights.holes
+         + f.bumpiness       * weights.bumpiness;
+}
+
+int Planner::scoreLock(const Board& board, const Shape& locked) const {
+    return lockScore(FeatureKernel::evaluate(board.getPlayfield(), locked));
+}
+
+int Planner::scorePlacement(const Board& board, const Shape& locked, int targetGridX, int targetGridY) const {
+    return placementScore(FeatureKernel::evaluate(board.getPlayfield(), locked), locked, targetGridX, targetGridY);
+}
+
+int Planner::placementScore(const Features& f, const Shape& locked, int targetGridX, int targetGridY) const noexcept {
+    return lockScore(f) + targetScore(f, locked, targetGridX, targetGridY);
+}
+
+// The part of a placement score that depends on the mouse target.
+int Planner::targetScore(const Features& f, const Shape& locked, int targetGridX, int targetGridY) const noexcept {
+    const int centreX = f.sumX / 4;
+
+    int rawDist = 0;
+    if (targetGridX < f.minX) rawDist = f.minX - targetGridX;
+    else if (targetGridX > f.maxX) rawDist = targetGridX - f.maxX;
+
+    const int ANCHOR_W = (int)anchorWeight;
+
+    int anchorDist = std::max(0, rawDist - 1);
+    anchorDist     = std::min(anchorDist, weights.anchorCap);
+    int anchorPen = -ANCHOR_W * anchorDist;
+
+    bool fillsTarget = (targetGridY >= 0) && shapeCoversCell(locked, targetGridX, targetGridY);
+    int yAlignBonus  = (targetGridY >= 0) ? -std::abs(f.minY - targetGridY) * weights.rowAlign : 0;
+
+    int score =
+          anchorPen
+        + (fillsTarget ? weights.fillBonus : 0)
+        + yAlignBonus;
+
+    score -= std::max(0, std::abs(centreX - targetGridX) - 1);
+    return score;
+}
+
+bool Planner::CacheKey::operator==(const CacheKey& o) const noexcept {
+    return position == o.position && rows == o.rows && cols == o.cols
+        && originX == o.originX && originY == o.originY
+        && targetX == o.targetX && targetY == o.targetY;
+}
+
+size_t Planner::CacheKeyHash::operator()(const CacheKey& k) const noexcept {
+    uint64_t h = k.position;
+    for (int v : {k.rows, k.cols, k.originX, k.originY, k.targetX, k.targetY}) {
+        h = (h ^ uint32_t(v)) * 0x100000001B3ull;
+        h ^= h >> 29;
+    }
+    return size_t(h);
+}
+
+Planner::CacheKey Planner::cacheKeyOf(const Board& board, const Shape& active) noexcept {
+    CacheKey key;
+    key.position = board.hash() ^ Board::pieceKey(active.getType(), active.getRotation());
+    key.rows     = board.getRows();
+    key.cols     = board.getCols();
+    key.originX  = active.getOriginX();
+    key.originY  = active.getOriginY();
+    return key;
+}
+
+void Planner::setCacheCapacity(size_t lockLists, size_t choices) {
+    lockCache.setCapacity(lockLists);
+    choiceCache.setCapacity(choices);
+}
+
+void Planner::setWeights(const PlacementWeights& w) {
+    if (w == weights) return;
+    weights = w;
+    // Cached lock sets carry base scores and cached choices depend on every term.
+    lockCache.clear();
+    choiceCache.clear();
+    hoverSetValid = false;
+}
+
+std::optional<Shape> Planner::planMousePlacement(const Board& board, const Shape& active,
+                                                int targetGridX, int targetGridY) {
+    CacheKey key = cacheKeyOf(board, active);
+    CacheKey choiceKey = key;
+    choiceKey.targetX = targetGridX;
+    choiceKey.targetY = targetGridY;
+
+    if (choiceCache.capacity() > 0) {
+        if (anchorWeight != choiceAnchorWeight) {
+            choiceCache.clear();
+            choiceAnchorWeight = anchorWeight;
+        }
+        if (const auto* hit = choiceCache.find(choiceKey)) {
+            ++cacheStats.choiceHits;
+            return *hit;
+        }
+        ++cacheStats.choiceMisses;
+    }
+
+    // Moving the target over the same board and piece only rescans the
+    // cheap target terms of the last lock set.
+    const ScoredLocks* set = nullptr;
+    if (reuseHoverSet && hoverSetValid && hoverKey == key) {
+        set = &hoverSet;
+        ++cacheStats.hoverHits;
+    } else if (lockCache.capacity() > 0) {
+        set = lockCache.find(key);
+        ++(set ? cacheStats.lockHits : cacheStats.lockMisses);
+    }
+    if (!set) {
+        computeReachableLocks(board, active, reachableLocks);
+        scoreLockSet(board, reachableLocks, hoverSet);
+        hoverKey      = key;
+        hoverSetValid = true;
+        lockCache.insert(key, hoverSet);
+        set = &hoverSet;
+    }
+
+    std::optional<Shape> choice = pickMouseLock(*set, targetGridX, targetGridY);
+    choiceCache.insert(choiceKey, choice);
+    return choice;
+}
+
+void Planner::scoreLockSet(const Board& board, const std::vector<Shape>& locks, ScoredLocks& out) {
+    const int count = (int)locks.size();
+    out.locks = locks;
+    out.features.resize(count);
+    out.baseScores.resize(count);
+
+    // Chunks write disjoint index ranges, so the result does not depend on
+    // how the work was split.
+    const int chunks = (pool && count >= ParallelMinLocks)
+                     ? std::min(pool->size() * 2, count / (ParallelMinLocks / 4))
+                     : 1;
+    auto scoreChunk = [&](int c) {
+        const int begin = int(int64_t(count) * c / chunks);
+        const int end   = int(int64_t(count) * (c + 1) / chunks);
+        FeatureKernel::evaluate(board.getPlayfield(), &out.locks[begin], end - begin, &out.features[begin]);
+        for (int i = begin; i < end; ++i) out.baseScores[i] = lockScore(out.features[i]);
+    };
+    if (chunks > 1) pool->run(chunks, scoreChunk);
+    else if (count > 0) scoreChunk(0);
+}
+
+std::optional<Shape> Planner::pickMouseLock(const ScoredLocks& set, int targetGridX, int targetGridY) const {
+    int bestScore = std::numeric_limits<int>::min();
+    int bestIdx   = -1;
+    for (int i = 0; i < (int)set.locks.size(); ++i) {
+        int s = set.baseScores[i] + targetScore(set.features[i], set.locks[i], targetGridX, targetGridY);
+        if (s > bestScore) {
+            bestScore = s;
+            bestIdx = i;
+        }
+    }
+
+    if (bestIdx < 0) return std::nullopt;
+    return set.locks[bestIdx];
+}
+
+std::optional<Shape> Planner::planBestPlacement(const Board& board, const Shape& active) {
+    auto& locks = reachableLocks;
+    computeReachableLocks(board, active, locks);
+
+    int bestScore = std::numeric_limits<int>::min();
+    int bestIdx   = -1;
+    Features features[FeatureKernel::BatchWidth];
+    for (int i = 0; i < (int)locks.size(); i += FeatureKernel::BatchWidth) {
+        const int n = std::min(FeatureKernel::BatchWidth, (int)locks.size() - i);
+        FeatureKernel::evaluate(board.getPlayfield(), &locks[i], n, features);
+        for (int k = 0; k < n; ++k) {
+            int s = lockScore(features[k]);
+            if (s > bestScore) {
+                bestScore = s;
+                bestIdx = i + k;
+            }
+        }
+    }
+
+    if (bestIdx < 0) return std::nullopt;
+    return locks[bestIdx];
+}
+
+Planner::Lookahead Planner::planLookahead(const Board& board, const Shape& active,
+                                          const std::deque<Shape>& preview,
+                                          const std::optional<Shape>& held, bool canHold,
+                                          const LookaheadOptions& options) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point start = Clock::now();
+    const bool hasDeadline = options.budgetMs > 0.0;
+    const Clock::time_point deadline = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(options.budgetMs));
+
+    Lookahead result;
+    const int width = std::max(1, options.beamWidth);
+    const int depth = std::clamp(options.depth, 1, int(preview.size()) + 1);
+    const int cols  = board.getCols();
+
+    beam.resize(1);
+    beam[0].board    = board;
+    beam[0].current  = active.getType();
+    beam[0].held     = held ? std::optional<Shape::Type>(held->getType()) : std::nullopt;
+    beam[0].queuePos = 0;
+    beam[0].canHold  = canHold && options.allowHold;
+    beam[0].carried  = 0;
+    beam[0].value    = 0;
+    rootMoves.clear();
+
+    for (int ply = 0; ply < depth; ++ply) {
+        beamChildren.clear();
+        bool outOfTime = false;
+
+        for (int p = 0; p < (int)beam.size(); ++p) {
+            if (ply > 0 && hasDeadline && Clock::now() >= deadline) { outOfTime = true; break; }
+            const BeamNode& node = beam[p];
+            if (!node.current) {
+                // Nothing left to place: carry the node over as it stands.
+                beamChildren.push_back({p, active, false, node.value, node.carried, (int)beamChildren.size()});
+                continue;
+            }
+
+            for (int option = 0; option < 2; ++option) {
+                const bool hold = option == 1;
+                Shape piece = (ply == 0) ? active : Shape(*node.current, cols / 2, 0);
+                if (hold) {
+                    if (!node.canHold) continue;
+                    if (node.held)                             piece = Shape(*node.held, cols / 2, 0);
+                    else if (node.queuePos < (int)preview.size()) piece = preview[node.queuePos];
+                    else                                       continue;
+                }
+                if (node.board.isOccupied(piece, 0, 0)) continue;
+
+                computeReachableLocks(node.board, piece, reachableLocks);
+                const int count = (int)reachableLocks.size();
+                beamFeatures.resize(count);
+                FeatureKernel::evaluate(node.board.getPlayfield(), reachableLocks.data(), count, beamFeatures.data());
+                result.nodes += count;
+
+                for (int i = 0; i < count; ++i) {
+                    const Features& f = beamFeatures[i];
+                    beamChildren.push_back({p, reachableLocks[i], hold,
+                                            node.carried + lockScore(f), node.carried + moveScore(f),
+                                            (int)beamChildren.size()});
+                }
+            }
+        }
+        if (outOfTime || beamChildren.empty()) break;
+
+        // Highest value first; ties keep generation order so runs repeat.
+        const int keep = std::min(width, (int)beamChildren.size());
+        std::partial_sort(beamChildren.begin(), beamChildren.begin() + keep, beamChildren.end(),
+                          [](const BeamChild& a, const BeamChild& b) {
+                              return a.value != b.value ? a.value > b.value : a.order < b.order;
+                          });
+
+        if ((int)nextBeam.size() < keep) nextBeam.resize(keep);
+        for (int k = 0; k < keep; ++k) {
+            const BeamChild& c      = beamChildren[k];
+            const BeamNode&  parent = beam[c.parent];
+            BeamNode&        next   = nextBeam[k];
+
+            next.board   = parent.board;
+            next.value   = c.value;
+            next.carried = c.carried;
+            if (!parent.current) {
+                next.current  = std::nullopt;
+                next.held     = parent.held;
+                next.queuePos = parent.queuePos;
+                next.canHold  = parent.canHold;
+                next.rootMove = parent.rootMove;
+                continue;
+            }
+
+            next.held     = parent.held;
+            next.queuePos = parent.queuePos;
+            if (c.hold) {
+                if (!parent.held) ++next.queuePos;
+                next.held = parent.current;
+            }
+            next.board.placeShape(c.lock);
+            if (next.board.clearFullLines() > 0) next.board.finalizeLineClear();
+
+            next.current = next.queuePos < (int)preview.size()
+                         ? std::optional<Shape::Type>(preview[next.queuePos].getType())
+                         : std::nullopt;
+            if (next.current) ++next.queuePos;
+            next.canHold = options.allowHold;
+
+            if (ply == 0) {
+                next.rootMove = (int)rootMoves.size();
+                rootMoves.emplace_back(c.hold, c.lock);
+            } else {
+                next.rootMove = parent.rootMove;
+            }
+        }
+        nextBeam.resize(keep);
+        beam.swap(nextBeam);
+        result.depthReached = ply + 1;
+    }
+
+    if (result.depthReached > 0) {
+        // The beam is sorted, so its first node is the best line found.
+        const auto& [hold, lock] = rootMoves[beam[0].rootMove];
+        result.hold = hold;
+        result.lock = lock;
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result;
+}
+
+void Planner::autoRotateCurrentShape(const Board& board, Shape& shape, int targetGridX, int targetGridY) const {
+    const int ANCHOR_W = anchorWeight;
+
+    const int rows = board.getRows();
+    const int cols = board.getCols();
+    const Playfield& field = board.getPlayfield();
+    const Shape original = shape;
+
+    struct RotInfo {
+        Shape shape;
+        int   minX, maxX, width;
+        explicit RotInfo(const Shape& s) : shape(s), minX(0), maxX(0), width(0) {}
+    };
+
+    auto computeBounds = [&](const Shape& s, int& mn, int& mx) {
+        mn = cols; mx = -1;
+        for (const auto& c : s.getCoords()) { mn = std::min(mn, c.first); mx = std::max(mx, c.first); }
+    };
+
+    // Always exactly four rotations, so they live on the stack.
+    std::array<RotInfo, 4> rots{RotInfo(original), RotInfo(original), RotInfo(original), RotInfo(original)};
+    for (int i = 0; i < 4; ++i) {
+        RotInfo& ri = rots[i];
+        if (i > 0) {
+            ri.shape = rots[i - 1].shape;
+            ri.shape.rotateClockwise(field);
+        }
+        computeBounds(ri.shape, ri.minX, ri.maxX);
+        ri.width = ri.maxX - ri.minX + 1;
+    }
+
+    int bestScore = std::numeric_limits<int>::min();
+    int bestTie   = std::numeric_limits<int>::max();
+    Shape best    = shape;
+    bool foundAny = false;
+
+    auto evalRange = [&](const RotInfo& base, int startX, int endX) {
+        bool localFound = false;
+        for (int xLeft = startX; xLeft <= endX; ++xLeft)
+        {
+            Shape cand = base.shape;
+            int dxShift = xLeft - base.minX;
+            cand.translate(dxShift, 0);
+            if (board.isOccupied(cand, 0, 0)) continue;
+
+            Shape dropped = cand;
+            dropped.translate(0, board.dropDistance(cand));
+
+            const Features f = FeatureKernel::evaluate(field, dropped);
+            const int centreX = f.sumX / 4;
+
+            int rawDist = 0;
+            if (targetGridX < f.minX) rawDist = f.minX - targetGridX;
+            else if (targetGridX > f.maxX) rawDist = targetGridX - f.maxX;
+            int anchorDist = std::max(0, rawDist - 1);
+            anchorDist     = std::min(anchorDist, weights.anchorCap);
+            int anchorPen  = -ANCHOR_W * anchorDist * anchorDist;
+
+            int dxPivot = std::abs(cand.getOriginX() - original.getOriginX());
+
+            bool fillsTarget = false;
+            if (targetGridY >= 0 && targetGridY < rows)
+                for (const auto& p : dropped.getCoords())
+                    if (p.first == targetGridX && p.second == targetGridY) { fillsTarget = true; break; }
+
+            int yAlignBonus = 0;
+            if (targetGridY >= 0 && targetGridY < rows)
+                yAlignBonus = -std::abs(f.minY - targetGridY) * weights.rowAlign;
+
+            int score =
+                  lockScore(f)
+                + anchorPen
+                + dxPivot      *  -weights.rotateStability
+                + (fillsTarget ? weights.rotateFillBonus : 0)
+                + yAlignBonus;
+
+            int tie = std::max(0, std::abs(centreX - targetGridX) - 1);
+
+            if (score > bestScore || (score == bestScore && tie < bestTie)) {
+                bestScore = score; bestTie = tie; best = cand; localFound = true;
+            }
+        }
+        return localFound;
+    };
+
+    for (const auto& base : rots)
+    {
+        int W = autoPlaceWindow;
+        int startX = std::max(0, targetGridX - W);
+        int endX   = std::min(cols - base.width, targetGridX + W);
+        if (startX <= endX) foundAny |= evalRange(base, startX, endX);
+        if (!foundAny && cols - base.width >= 0) foundAny |= evalRange(base, 0, cols - base.width);
+    }
+
+    shape = best;
+}
+
+int Planner::countContactSegments(const Shape& shape, const Board& board) {
+    return FeatureKernel::countContacts(board.getPlayfield(), shape);
+}
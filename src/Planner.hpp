@@ -0,0 +1,166 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "Board.hpp"
+#include "FeatureKernel.hpp"
+#include "LruCache.hpp"
+#include "PlacementWeights.hpp"
+#include "Shape.hpp"
+#include "WorkerPool.hpp"
+
+// Placement search and scoring shared by the mouse assist and headless
+// self-play. Holds its own scratch buffers, so use one instance per thread.
+// Scoring is reentrant; with a worker pool attached, large candidate sets
+// are scored in parallel.
+class Planner {
+public:
+    static constexpr int ParallelMinLocks = 128;
+
+    struct CacheStats {
+        uint64_t lockHits     = 0;
+        uint64_t lockMisses   = 0;
+        uint64_t choiceHits   = 0;
+        uint64_t choiceMisses = 0;
+        uint64_t hoverHits    = 0;   // target moved, lock set reused
+
+        double lockHitRate() const noexcept   { return rate(lockHits, lockMisses); }
+        double choiceHitRate() const noexcept { return rate(choiceHits, choiceMisses); }
+
+    private:
+        static double rate(uint64_t hits, uint64_t misses) noexcept {
+            return hits + misses ? double(hits) / double(hits + misses) : 0.0;
+        }
+    };
+
+    struct LookaheadOptions {
+        int    depth     = 3;      // plies, counting the active piece
+        int    beamWidth = 8;
+        double budgetMs  = 8.0;    // wall-clock cap per decision; 0 means none
+        bool   allowHold = true;
+    };
+
+    struct Lookahead {
+        std::optional<Shape> lock;  // for the piece that is active after the hold, if any
+        bool     hold         = false;
+        int      depthReached = 0;
+        uint64_t nodes        = 0;
+        double   seconds      = 0.0;
+
+        double nodesPerSecond() const noexcept { return seconds > 0.0 ? double(nodes) / seconds : 0.0; }
+    };
+
+    int   autoPlaceWindow = 2;
+    float anchorWeight    = 2.0f;
+    // Keep the last lock set so a moving mouse target only rescans the
+    // target terms. Turned off, every uncached plan runs the full search.
+    bool  reuseHoverSet   = true;
+
+    void setWorkerPool(WorkerPool* workers) noexcept { pool = workers; }
+
+    // Replacing the weights drops every cached lock set and choice.
+    void setWeights(const PlacementWeights& w);
+    const PlacementWeights& getWeights() const noexcept { return weights; }
+
+    // planMousePlacement remembers reachable-lock lists per (board, piece
+    // state) and chosen locks per (board, piece state, target cell). Keys
+    // include Board::hash(), so placing or clearing lines moves on to fresh
+    // entries. Both capacities default to zero, which disables caching.
+    void setCacheCapacity(size_t lockLists, size_t choices);
+    const CacheStats& getCacheStats() const noexcept { return cacheStats; }
+    void resetCacheStats() noexcept { cacheStats = {}; }
+
+    void computeReachableLocks(const Board& board, const Shape& start, std::vector<Shape>& locks) const;
+
+    // Target-independent part of the score: board shape after the lock.
+    int  scoreLock(const Board& board, const Shape& locked) const;
+    int  scorePlacement(const Board& board, const Shape& locked, int targetGridX, int targetGridY) const;
+
+    std::optional<Shape> planMousePlacement(const Board& board, const Shape& active, int targetGridX, int targetGridY);
+    std::optional<Shape> planBestPlacement(const Board& board, const Shape& active);
+    // Beam search over the preview queue and the hold swap. Completes at
+    // least the first ply even if the budget has already run out.
+    Lookahead planLookahead(const Board& board, const Shape& active, const std::deque<Shape>& preview,
+                            const std::optional<Shape>& held, bool canHold, const LookaheadOptions& options);
+    void autoRotateCurrentShape(const Board& board, Shape& shape, int targetGridX, int targetGridY = -1) const;
+
+    // Candidates of the last search that was not answered from the cache.
+    const std::vector<Shape>& getReachableLocks() const noexcept { return reachableLocks; }
+
+    static int  countContactSegments(const Shape& shape, const Board& board);
+    static int  minYOf(const Shape& s) noexcept;
+    static bool shapeCoversCell(const Shape& s, int gx, int gy) noexcept;
+
+private:
+    struct CacheKey {
+        uint64_t position = 0;
+        int      rows = 0, cols = 0;
+        int      originX = 0, originY = 0;
+        int      targetX = -1, targetY = -1;
+
+        bool operator==(const CacheKey& o) const noexcept;
+    };
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& k) const noexcept;
+    };
+
+    static CacheKey cacheKeyOf(const Board& board, const Shape& active) noexcept;
+
+    using Features = FeatureKernel::Features;
+    int moveScore(const Features& f) const noexcept;
+    int lockScore(const Features& f) const noexcept;
+    int placementScore(const Features& f, const Shape& locked, int targetGridX, int targetGridY) const noexcept;
+    int targetScore(const Features& f, const Shape& locked, int targetGridX, int targetGridY) const noexcept;
+
+    // Reachable locks with their target-independent features and scores.
+    struct ScoredLocks {
+        std::vector<Shape>    locks;
+        std::vector<Features> features;
+        std::vector<int>      baseScores;
+    };
+
+    void scoreLockSet(const Board& board, const std::vector<Shape>& locks, ScoredLocks& out);
+    std::optional<Shape> pickMouseLock(const ScoredLocks& set, int targetGridX, int targetGridY) const;
+
+    ScoredLocks hoverSet;
+    CacheKey    hoverKey;
+    bool        hoverSetValid = false;
+
+    LruCache<CacheKey, ScoredLocks, CacheKeyHash>          lockCache;
+    LruCache<CacheKey, std::optional<Shape>, CacheKeyHash> choiceCache;
+    CacheStats                                             cacheStats;
+    float                                                  choiceAnchorWeight = 0.0f;
+
+    struct BeamNode {
+        Board                      board{1, 1};
+        std::optional<Shape::Type> current;     // empty once the known queue runs out
+        std::optional<Shape::Type> held;
+        int                        queuePos = 0;
+        bool                       canHold  = true;
+        int                        carried  = 0; // move terms summed along the path
+        int                        value    = 0;
+        int                        rootMove = 0;
+    };
+    struct BeamChild {
+        int   parent;
+        Shape lock;
+        bool  hold;
+        int   value;
+        int   carried;
+        int   order;
+    };
+
+    PlacementWeights              weights;
+    WorkerPool*                   pool = nullptr;
+    std::vector<Shape>            reachableLocks;
+    std::vector<BeamNode>         beam, nextBeam;
+    std::vector<BeamChild>        beamChildren;
+    std::vector<Features>         beamFeatures;
+    std::vector<std::pair<bool, Shape>> rootMoves;
+    mutable std::vector<uint64_t> lockSeenScratch;
+};
@@ -0,0 +1,176 @@
+#include "Playfield.hpp"
+#include "Shape.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+int Playfield::checkedRows(int rows, int cols) {
+    if (cols <= 0 || cols > MaxCols || rows <= 0)
+        throw std::invalid_argument("Playfield dimensions out of range");
+    return rows;
+}
+
+// checkedRows() runs first, so nothing below sees bad dimensions.
+Playfield::Playfield(int rows, int cols)
+    : rows(checkedRows(rows, cols)), cols(cols),
+      fullMask(cols >= MaxCols ? ~RowMask(0) : (RowMask(1u) << cols) - 1u),
+      masks(size_t(rows) + 2, 0),
+      colors(size_t(rows) * size_t(cols), 0),
+      rowMap(rows),
+      spareRows(rows),
+      columnTops(cols, rows),
+      columnHoles(cols, 0) {
+    std::iota(rowMap.begin(), rowMap.end(), 0);
+    masks.front() = masks.back() = fullMask;
+}
+
+bool Playfield::isOccupied(const Shape& shape, int dx, int dy) const noexcept {
+    for (const auto& coord : shape.getCoords()) {
+        const int x = coord.first + dx;
+        const int y = coord.second + dy;
+
+        if (x < 0 || x >= cols || y >= rows) return true;
+        if (y < 0) continue;
+        if (masks[y + 1] & (RowMask(1u) << x)) return true;
+    }
+    return false;
+}
+
+Playfield::PlacementStats Playfield::evaluatePlacement(const Shape& shape) const noexcept {
+    constexpr int Span = 4;
+    const Shape::Coords cells = shape.getCoords();
+
+    int minX = cols, maxX = -1;
+    for (const auto& c : cells) {
+        if (c.first < 0 || c.first >= cols || c.second < 0 || c.second >= rows) continue;
+        minX = std::min(minX, c.first);
+        maxX = std::max(maxX, c.first);
+    }
+
+    PlacementStats st;
+    st.clearedLines    = fullLines;
+    st.aggregateHeight = aggregateHeight;
+    st.holes           = totalHoles;
+    st.bumpiness       = bumpiness;
+    if (maxX < 0 || maxX - minX >= Span) return st;
+
+    int     tops[Span];
+    RowMask rowBits[Span];
+    int     rowIds[Span];
+    int     rowCount = 0;
+    for (int c = minX; c <= maxX; ++c) tops[c - minX] = columnTops[c];
+
+    for (const auto& c : cells) {
+        const int x = c.first, y = c.second;
+        if (x < 0 || x >= cols || y < 0 || y >= rows) continue;
+
+        int& top = tops[x - minX];
+        if (y < top) { st.holes += top - y - 1; top = y; }
+        else         { --st.holes; }
+
+        int r = 0;
+        while (r < rowCount && rowIds[r] != y) ++r;
+        if (r == rowCount) { rowIds[rowCount] = y; rowBits[rowCount++] = getRowMask(y); }
+        rowBits[r] |= RowMask(1u) << x;
+    }
+    for (int r = 0; r < rowCount; ++r)
+        if (rowBits[r] == fullMask && getRowMask(rowIds[r]) != fullMask) ++st.clearedLines;
+
+    auto heightAfter = [&](int c) {
+        return rows - ((c >= minX && c <= maxX) ? tops[c - minX] : columnTops[c]);
+    };
+    for (int c = minX; c <= maxX; ++c) st.aggregateHeight += columnTops[c] - tops[c - minX];
+    for (int c = std::max(0, minX - 1); c <= std::min(cols - 2, maxX); ++c) {
+        st.bumpiness -= std::abs(columnTops[c] - columnTops[c + 1]);
+        st.bumpiness += std::abs(heightAfter(c) - heightAfter(c + 1));
+    }
+    return st;
+}
+
+void Playfield::fillCell(int x, int y, uint8_t colorIndex) noexcept {
+    const RowMask bit = RowMask(1u) << x;
+    colors[size_t(rowMap[y]) * cols + x] = colorIndex;
+    RowMask& mask = row(y);
+    if (mask & bit) return;
+
+    mask |= bit;
+    if (mask == fullMask) ++fullLines;
+
+    const int top = columnTops[x];
+    if (y < top) {
+        columnHoles[x] += top - y - 1;
+        totalHoles     += top - y - 1;
+        setColumnTop(x, y);
+    } else {
+        --columnHoles[x];
+        --totalHoles;
+    }
+}
+
+void Playfield::setColumnTop(int x, int top) noexcept {
+    const int oldTop = columnTops[x];
+    if (x > 0)
+        bumpiness += std::abs(top - columnTops[x - 1]) - std::abs(oldTop - columnTops[x - 1]);
+    if (x < cols - 1)
+        bumpiness += std::abs(top - columnTops[x + 1]) - std::abs(oldTop - columnTops[x + 1]);
+    aggregateHeight += oldTop - top;
+    columnTops[x] = top;
+}
+
+void Playfield::rebuildColumnStats() noexcept {
+    std::fill(columnTops.begin(), columnTops.end(), rows);
+    std::fill(columnHoles.begin(), columnHoles.end(), 0);
+    totalHoles = aggregateHeight = bumpiness = fullLines = 0;
+
+    RowMask covered = 0;
+    for (int y = 0; y < rows; ++y) {
+        const RowMask bits = getRowMask(y);
+        if (bits == fullMask) ++fullLines;
+
+        for (RowMask fresh = bits & ~covered; fresh; fresh &= fresh - 1)
+            columnTops[__builtin_ctz(fresh)] = y;
+        for (RowMask gaps = covered & ~bits; gaps; gaps &= gaps - 1)
+            ++columnHoles[__builtin_ctz(gaps)];
+        covered |= bits;
+    }
+    for (int x = 0; x < cols; ++x) {
+        totalHoles      += columnHoles[x];
+        aggregateHeight += rows - columnTops[x];
+        if (x < cols - 1) bumpiness += std::abs(columnTops[x] - columnTops[x + 1]);
+    }
+}
+
+void Playfield::removeLines(const std::vector<int>& lines) {
+    if (lines.empty()) return;
+
+    // Color rows never move: the row map is compacted instead, and the
+    // physical rows of cleared lines are recycled as the new top rows.
+    size_t next  = 0;
+    int    freed = 0;
+    int    write = rows - 1;
+    for (int read = rows - 1; read >= 0; --read) {
+        if (next < lines.size() && lines[next] == read) {
+            spareRows[freed++] = rowMap[read];
+            ++next;
+            continue;
+        }
+        rowMap[write] = rowMap[read];
+        row(write)    = row(read);
+        --write;
+    }
+    for (int i = 0; i < freed; ++i) {
+        rowMap[i] = spareRows[i];
+        row(i)    = 0;
+        std::memset(&colors[size_t(rowMap[i]) * cols], 0, size_t(cols));
+    }
+    rebuildColumnStats();
+}
+
+void Playfield::clear() noexcept {
+    std::fill(masks.begin() + 1, masks.end() - 1, 0);
+    std::fill(colors.begin(), colors.end(), 0);
+    rebuildColumnStats();
+}
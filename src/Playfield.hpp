@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Shape;
+
+class Playfield {
+public:
+    using RowMask = uint32_t;
+
+    static constexpr int MaxCols = 32;
+
+    struct PlacementStats {
+        int clearedLines    = 0;
+        int aggregateHeight = 0;
+        int holes           = 0;
+        int bumpiness       = 0;
+    };
+
+    Playfield(int rows, int cols);
+
+    int     getRows() const noexcept     { return rows; }
+    int     getCols() const noexcept     { return cols; }
+    RowMask getFullMask() const noexcept { return fullMask; }
+    RowMask getRowMask(int y) const noexcept { return masks[y + 1]; }
+    // Rows -1 through `rows`; the two border rows read as full.
+    const RowMask* getPaddedRows() const noexcept { return masks.data(); }
+    const int*     getColumnTops() const noexcept { return columnTops.data(); }
+
+    bool isCellFilled(int x, int y) const noexcept {
+        return (masks[y + 1] >> x) & 1u;
+    }
+    uint8_t getColorIndex(int x, int y) const noexcept { return colors[size_t(rowMap[y]) * cols + x]; }
+    bool isRowFull(int y) const noexcept { return masks[y + 1] == fullMask; }
+
+    int  getColumnTop(int x) const noexcept    { return columnTops[x]; }
+    int  getColumnHeight(int x) const noexcept { return rows - columnTops[x]; }
+    int  getColumnHoles(int x) const noexcept  { return columnHoles[x]; }
+    int  getTotalHoles() const noexcept        { return totalHoles; }
+    int  getAggregateHeight() const noexcept   { return aggregateHeight; }
+    int  getBumpiness() const noexcept         { return bumpiness; }
+    int  countFullLines() const noexcept       { return fullLines; }
+    bool isColumnClearAbove(int x, int y) const noexcept { return y < 0 || columnTops[x] >= y; }
+
+    bool isOccupied(const Shape& shape, int dx, int dy) const noexcept;
+    PlacementStats evaluatePlacement(const Shape& shape) const noexcept;
+
+    void fillCell(int x, int y, uint8_t colorIndex) noexcept;
+    // `lines` must be sorted bottom-up (descending), as Board::clearFullLines produces them.
+    void removeLines(const std::vector<int>& lines);
+    void clear() noexcept;
+
+private:
+    static int checkedRows(int rows, int cols);
+
+    int     rows;
+    int     cols;
+    RowMask fullMask;
+
+    std::vector<RowMask> masks;   // padded: masks[y + 1] is row y
+    std::vector<uint8_t> colors;
+    std::vector<int>     rowMap;
+    std::vector<int>     spareRows;
+
+    std::vector<int> columnTops;
+    std::vector<int> columnHoles;
+    int              totalHoles      = 0;
+    int              aggregateHeight = 0;
+    int              bumpiness       = 0;
+    int              fullLines       = 0;
+
+    RowMask& row(int y) noexcept { return masks[y + 1]; }
+
+    void setColumnTop(int x, int top) noexcept;
+    void rebuildColumnStats() noexcept;
+};
@@ -60,6 +60,42 @@ private:
 };
 
 
+// Text rendered once and kept as a texture between frames. get() rebuilds it
+// only when the renderer, font, text or colour differs from the previous call;
+// alpha is applied as a texture modulation so fading text is not re-rendered.
+class UITextTexture {
+public:
+    UITextTexture() = default;
+    UITextTexture(const UITextTexture&);
+    UITextTexture& operator=(const UITextTexture&);
+    ~UITextTexture();
+
+    SDL_Texture* get(SDL_Renderer* renderer, TTF_Font* font, const std::string& text, SDL_Color color);
+    int width() const { return w; }
+    int height() const { return h; }
+    void reset();
+
+    // Disowns every cached texture; call before the renderer is destroyed,
+    // which frees them. Widgets that outlive it then never touch the stale
+    // handles and rebuild on their next get().
+    static void releaseAll();
+
+private:
+    SDL_Texture*  texture = nullptr;
+    SDL_Renderer* owner   = nullptr;
+    TTF_Font*     font    = nullptr;
+    std::string   text;
+    SDL_Color     color{ 0, 0, 0, 0 };
+    int           w = 0, h = 0;
+    bool          built = false;
+    unsigned      builtGeneration = 0;
+
+    // Bumped by releaseAll(). A plain integer, so it stays valid while
+    // widgets held by namespace-scope statics are destroyed at exit.
+    static unsigned generation;
+};
+
+
 class UIElement {
 public:
     SDL_Rect bounds;
@@ -128,6 +164,8 @@ private:
     std::shared_ptr<UIButton> okButton;
     std::shared_ptr<UIButton> cancelButton;
     bool ignoreNextClick = true;
+    UITextTexture titleTex;
+    UITextTexture messageTex;
 };
 
 
@@ -206,6 +244,7 @@ private:
     bool pressed = false;
     bool focused = false;
     bool focusable = true;
+    UITextTexture labelTex;
 };
 
 
@@ -256,6 +295,7 @@ private:
     bool focused = false;
     bool focusable = true;
     int pressOffset = 1;
+    UITextTexture labelTex;
 };
 
 
@@ -273,6 +313,7 @@ private:
     std::string text;
     TTF_Font* font = nullptr;
     SDL_Color color = {255, 255, 255, 255};
+    UITextTexture textTex;
 };
 
 
@@ -306,6 +347,7 @@ private:
     SDL_Color customBoxBgColor{};   bool hasCustomBoxBgColor   = false;
     SDL_Color customBorderColor{};  bool hasCustomBorderColor  = false;
     int borderPx = 1;
+    UITextTexture labelTex;
 };
 
 
@@ -382,6 +424,10 @@ private:
     bool focused = false;
     bool focusable = true;
     int  cornerRadius = 8;
+
+    UITextTexture selectedTex;
+    UITextTexture hoveredTex;               // the highlighted item, drawn in a different colour
+    std::vector<UITextTexture> optionTex;   // one per option
 };
 
 
@@ -433,6 +479,7 @@ class UISpinner : public UIElement {
         HeldButton heldButton = HeldButton::NONE;
         Uint32 pressStartTime = 0;
         Uint32 lastStepTime = 0;
+        UITextTexture valueTex;
 };
 
 
@@ -493,6 +540,7 @@ private:
     std::string title;
     std::vector<std::shared_ptr<UIElement>> children;
     TTF_Font* font = nullptr;
+    UITextTexture titleTex;
 };
 
 
@@ -600,6 +648,57 @@ TTF_Font* getThemeFont(const UITheme& theme) {
 }
 
 
+unsigned UITextTexture::generation = 0;
+
+// Copies start empty and build their own texture on first use.
+UITextTexture::UITextTexture(const UITextTexture&) {}
+
+UITextTexture& UITextTexture::operator=(const UITextTexture& other) {
+    if (this != &other) reset();
+    return *this;
+}
+
+UITextTexture::~UITextTexture() {
+    reset();
+}
+
+void UITextTexture::reset() {
+    if (texture && builtGeneration == generation) SDL_DestroyTexture(texture);
+    texture = nullptr;
+    w = h = 0;
+    built = false;
+}
+
+void UITextTexture::releaseAll() {
+    ++generation;
+}
+
+SDL_Texture* UITextTexture::get(SDL_Renderer* renderer, TTF_Font* f, const std::string& s, SDL_Color c) {
+    const bool current = built && builtGeneration == generation && owner == renderer && font == f && text == s &&
+                         color.r == c.r && color.g == c.g && color.b == c.b;
+    if (!current) {
+        reset();
+        owner = renderer;
+        font  = f;
+        text  = s;
+        color = c;
+        builtGeneration = generation;
+        built = true;  // a failed render is not retried until the inputs change
+
+        SDL_Color opaque = c; opaque.a = 255;
+        SDL_Surface* surf = (f && !s.empty()) ? TTF_RenderText_Blended(f, s.c_str(), opaque) : nullptr;
+        if (surf) {
+            texture = SDL_CreateTextureFromSurface(renderer, surf);
+            w = surf->w;
+            h = surf->h;
+            SDL_FreeSurface(surf);
+        }
+    }
+    if (texture) SDL_SetTextureAlphaMod(texture, c.a);
+    return texture;
+}
+
+
 TTF_Font* UIConfig::defaultFont = nullptr;
 UITheme UIConfig::defaultTheme;
 
@@ -701,33 +800,24 @@ void UIDialog::render(SDL_Renderer* renderer) {
     SDL_SetRenderDrawColor(renderer, theme.borderColor.r, theme.borderColor.g, theme.borderColor.b, theme.borderColor.a);
     SDL_RenderDrawRect(renderer, &bounds);
 
-    SDL_Surface* titleSurf = TTF_RenderText_Blended(font, title.c_str(), theme.textColor);
-    SDL_Surface* msgSurf = TTF_RenderText_Blended(font, message.c_str(), theme.textColor);
-
-    if (titleSurf) {
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, titleSurf);
+    if (SDL_Texture* tex = titleTex.get(renderer, font, title, theme.textColor)) {
         SDL_Rect titleRect = {
             bounds.x + 20,
             bounds.y + 20,
-            titleSurf->w,
-            titleSurf->h
+            titleTex.width(),
+            titleTex.height()
         };
         SDL_RenderCopy(renderer, tex, nullptr, &titleRect);
-        SDL_FreeSurface(titleSurf);
-        SDL_DestroyTexture(tex);
     }
 
-    if (msgSurf) {
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, msgSurf);
+    if (SDL_Texture* tex = messageTex.get(renderer, font, message, theme.textColor)) {
         SDL_Rect msgRect = {
             bounds.x + 20,
             bounds.y + 70,
-            msgSurf->w,
-            msgSurf->h
+            messageTex.width(),
+            messageTex.height()
         };
         SDL_RenderCopy(renderer, tex, nullptr, &msgRect);
-        SDL_FreeSurface(msgSurf);
-        SDL_DestroyTexture(tex);
     }
 
     UIPopup::render(renderer);
@@ -995,13 +1085,11 @@ void UIRadioButton::render(SDL_Renderer* renderer) {
     }
 
     SDL_Color textCol = {0, 0, 0,255};
-    SDL_Surface* s = TTF_RenderText_Blended(activeFont, label.c_str(), textCol);
-    if (!s) return;
-    SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-    SDL_Rect textRect = { bounds.x + 30, bounds.y + (bounds.h - (s->h))/2, s->w, s->h };
+    SDL_Texture* t = labelTex.get(renderer, activeFont, label, textCol);
+    if (!t) return;
+    const int tw = labelTex.width(), th = labelTex.height();
+    SDL_Rect textRect = { bounds.x + 30, bounds.y + (bounds.h - th)/2, tw, th };
     SDL_RenderCopy(renderer, t, nullptr, &textRect);
-    SDL_FreeSurface(s);
-    SDL_DestroyTexture(t);
 }
 
 
@@ -1106,14 +1194,11 @@ void UIButton::render(SDL_Renderer* renderer) {
     if (!activeFont) return;
 
     SDL_Color txt = baseText; txt.a = globalAlpha;
-    SDL_Surface* s = TTF_RenderText_Blended(activeFont, label.c_str(), txt);
-    if (!s) return;
-    SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-    if (!t) { SDL_FreeSurface(s); return; }
-    SDL_Rect r = { dst.x + (dst.w - s->w)/2, dst.y + (dst.h - s->h)/2, s->w, s->h };
+    SDL_Texture* t = labelTex.get(renderer, activeFont, label, txt);
+    if (!t) return;
+    const int tw = labelTex.width(), th = labelTex.height();
+    SDL_Rect r = { dst.x + (dst.w - tw)/2, dst.y + (dst.h - th)/2, tw, th };
     SDL_RenderCopy(renderer, t, nullptr, &r);
-    SDL_FreeSurface(s);
-    SDL_DestroyTexture(t);
 }
 
 
@@ -1156,30 +1241,17 @@ void UILabel::render(SDL_Renderer* renderer) {
 
     const SDL_Color& textColor = (color.a == 0) ? getTheme().textColor : color;
 
-    SDL_Surface* textSurface = TTF_RenderText_Blended(activeFont, text.c_str(), textColor);
-    if (!textSurface) {
-        SDL_Log("UILabel: Failed to render text surface: %s", TTF_GetError());
-        return;
-    }
-
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, textSurface);
-    if (!texture) {
-        SDL_Log("UILabel: Failed to create texture from surface: %s", SDL_GetError());
-        SDL_FreeSurface(textSurface);
-        return;
-    }
+    SDL_Texture* texture = textTex.get(renderer, activeFont, text, textColor);
+    if (!texture) return;
 
     SDL_Rect dstRect = {
         bounds.x,
-        bounds.y + (bounds.h - textSurface->h) / 2,
-        textSurface->w,
-        textSurface->h
+        bounds.y + (bounds.h - textTex.height()) / 2,
+        textTex.width(),
+        textTex.height()
     };
 
     SDL_RenderCopy(renderer, texture, nullptr, &dstRect);
-
-    SDL_FreeSurface(textSurface);
-    SDL_DestroyTexture(texture);
 }
 
 
@@ -1295,13 +1367,11 @@ void UICheckbox::render(SDL_Renderer* renderer) {
     }
 
     const int textLeft = box.x + box.w + 8;
-    SDL_Surface* s = TTF_RenderText_Blended(activeFont, label.c_str(), textCol);
-    if (!s) return;
-    SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-    SDL_Rect tr = { textLeft, bounds.y + (bounds.h - s->h)/2, s->w, s->h };
+    SDL_Texture* t = labelTex.get(renderer, activeFont, label, textCol);
+    if (!t) return;
+    const int tw = labelTex.width(), th = labelTex.height();
+    SDL_Rect tr = { textLeft, bounds.y + (bounds.h - th)/2, tw, th };
     SDL_RenderCopy(renderer, t, nullptr, &tr);
-    SDL_DestroyTexture(t);
-    SDL_FreeSurface(s);
 }
 
 
@@ -1646,15 +1716,10 @@ void UIComboBox::render(SDL_Renderer* renderer) {
 
         // Text
         const std::string selectedText = options.empty() ? "" : options[selectedIndex.get()];
-        if (!selectedText.empty()) {
-            SDL_Surface* s = TTF_RenderText_Blended(activeFont, selectedText.c_str(), textCol);
-            if (s) {
-                SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-                SDL_Rect tr{ inner.x + 10, inner.y + (inner.h - s->h)/2, s->w, s->h };
-                SDL_RenderCopy(renderer, t, nullptr, &tr);
-                SDL_DestroyTexture(t);
-                SDL_FreeSurface(s);
-            }
+        if (SDL_Texture* t = selectedTex.get(renderer, activeFont, selectedText, textCol)) {
+            const int th = selectedTex.height();
+            SDL_Rect tr{ inner.x + 10, inner.y + (inner.h - th)/2, selectedTex.width(), th };
+            SDL_RenderCopy(renderer, t, nullptr, &tr);
         }
 
         // Chevron (smooth V) at right using rounded strokes
@@ -1682,6 +1747,7 @@ void UIComboBox::render(SDL_Renderer* renderer) {
         SDL_RenderDrawRect(renderer, &listRect);
 
         // Items
+        optionTex.resize(options.size());
         for (int i = 0; i < (int)options.size(); ++i) {
             SDL_Rect itemRect{ listRect.x, listRect.y + i*ih, listRect.w, ih };
             bool active = (i == hoveredIndex);
@@ -1692,13 +1758,10 @@ void UIComboBox::render(SDL_Renderer* renderer) {
                 SDL_SetRenderDrawColor(renderer, bg.r, bg.g, bg.b, bg.a);
                 SDL_RenderFillRect(renderer, &itemRect);
             }
-            SDL_Surface* s = TTF_RenderText_Blended(activeFont, options[i].c_str(), fg);
-            if (s) {
-                SDL_Texture* t = SDL_CreateTextureFromSurface(renderer, s);
-                SDL_Rect tr{ itemRect.x + 10, itemRect.y + (itemRect.h - s->h)/2, s->w, s->h };
+            UITextTexture& cache = active ? hoveredTex : optionTex[i];
+            if (SDL_Texture* t = cache.get(renderer, activeFont, options[i], fg)) {
+                SDL_Rect tr{ itemRect.x + 10, itemRect.y + (itemRect.h - cache.height())/2, cache.width(), cache.height() };
                 SDL_RenderCopy(renderer, t, nullptr, &tr);
-                SDL_DestroyTexture(t);
-                SDL_FreeSurface(s);
             }
         }
     }
@@ -1944,18 +2007,14 @@ void UISpinner::render(SDL_Renderer* renderer) {
 
     std::ostringstream oss;
     oss << value.get();
-    SDL_Surface* surface = TTF_RenderText_Blended(activeFont, oss.str().c_str(), theme.textColor);
-    if (surface) {
-        SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (SDL_Texture* texture = valueTex.get(renderer, activeFont, oss.str(), theme.textColor)) {
         SDL_Rect textRect = {
-            centerRect.x + (centerRect.w - surface->w) / 2,
-            centerRect.y + (centerRect.h - surface->h) / 2,
-            surface->w,
-            surface->h
+            centerRect.x + (centerRect.w - valueTex.width()) / 2,
+            centerRect.y + (centerRect.h - valueTex.height()) / 2,
+            valueTex.width(),
+            valueTex.height()
         };
         SDL_RenderCopy(renderer, texture, nullptr, &textRect);
-        SDL_FreeSurface(surface);
-        SDL_DestroyTexture(texture);
     }
 }
 
@@ -2324,18 +2383,14 @@ void UIGroupBox::render(SDL_Renderer* renderer) {
     SDL_RenderDrawLine(renderer, bounds.x, bounds.y + bounds.h, bounds.x + bounds.w, bounds.y + bounds.h);
 
     if (!title.empty() && font) {
-        SDL_Surface* surf = TTF_RenderText_Blended(font, title.c_str(), theme.textColor);
-        if (surf) {
-            SDL_Texture* tex = SDL_CreateTextureFromSurface(renderer, surf);
+        if (SDL_Texture* tex = titleTex.get(renderer, font, title, theme.textColor)) {
             SDL_Rect textRect = {
                 bounds.x + padding + 4,
-                bounds.y - surf->h / 2,
-                surf->w,
-                surf->h
+                bounds.y - titleTex.height() / 2,
+                titleTex.width(),
+                titleTex.height()
             };
             SDL_RenderCopy(renderer, tex, nullptr, &textRect);
-            SDL_FreeSurface(surf);
-            SDL_DestroyTexture(tex);
         }
     }
 
@@ -2602,6 +2657,7 @@ namespace FormUI {
     }
 
     void Shutdown() {
+        UITextTexture::releaseAll();
         uiManager.cleanupCursors();
     }
 
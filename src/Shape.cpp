@@ -1,207 +1,168 @@
 #include "Shape.hpp"
-
-Shape::Shape(Type type, int startX, int startY, SDL_Color color)
-    : rotationState(0), type(type), color(color){
-    coords = getDefaultCoordsForType(type);
-
-    for (auto& coord : coords) {
-        coord.first += startX;
-        coord.second += startY;
+#include "Playfield.hpp"
+
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<Shape>, "Shape is copied freely by the planner");
+
+namespace {
+struct Offset { int x, y; };
+using CellOffsets = std::array<Offset, 4>;
+using RotationSet = std::array<CellOffsets, 4>;
+
+// Spawn layouts; the first cell is the rotation pivot and the piece origin.
+constexpr std::array<CellOffsets, Shape::TypeCount> spawnOffsets = {{
+    {{{-1, 0}, {0, 0}, {-1, 1}, {0, 1}}},
+    {{{-1, 0}, {-2, 0}, {0, 0}, {1, 0}}},
+    {{{0, 0}, {-1, 0}, {0, 1}, {1, 1}}},
+    {{{0, 0}, {1, 0}, {0, 1}, {-1, 1}}},
+    {{{-1, 1}, {-1, 0}, {-1, 2}, {0, 2}}},
+    {{{0, 1}, {0, 0}, {0, 2}, {-1, 2}}},
+    {{{0, 0}, {-1, 1}, {0, 1}, {1, 1}}}
+}};
+
+constexpr std::array<RotationSet, Shape::TypeCount> buildRotationTable() {
+    std::array<RotationSet, Shape::TypeCount> table{};
+    for (int t = 0; t < Shape::TypeCount; ++t) {
+        const Offset pivot = spawnOffsets[t][0];
+        for (int i = 0; i < 4; ++i) {
+            table[t][0][i] = { spawnOffsets[t][i].x - pivot.x, spawnOffsets[t][i].y - pivot.y };
+        }
+        for (int r = 1; r < 4; ++r) {
+            for (int i = 0; i < 4; ++i) {
+                const Offset prev = table[t][r - 1][i];
+                table[t][r][i] = { -prev.y, prev.x };
+            }
+        }
     }
-
-    static const std::unordered_map<Type, SDL_Color> shapeColors = {
-        {Type::O, {255, 215, 0, 255}},
-        {Type::I, {0, 255, 255, 255}},
-        {Type::S, {0, 255, 0, 255}},
-        {Type::Z, {255, 0, 0, 255}},
-        {Type::L, {255, 140, 0, 255}},
-        {Type::J, {0, 0, 255, 255}},
-        {Type::T, {128, 0, 128, 255}}
-    };
-    this->color = shapeColors.at(type);
+    return table;
 }
 
-const std::vector<std::pair<int, int>>& Shape::getDefaultCoordsForType(Type type) {
-    static const std::unordered_map<Type, std::vector<std::pair<int, int>>> coordsMap = {
-        {Type::O, {{-1, 0}, {0, 0}, {-1, 1}, {0, 1}}},
-        {Type::I, {{-1, 0}, {-2, 0}, {0, 0}, {1, 0}}},
-        {Type::S, {{0, 0}, {-1, 0}, {0, 1}, {1, 1}}},
-        {Type::Z, {{0, 0}, {1, 0}, {0, 1}, {-1, 1}}},
-        {Type::L, {{-1, 1}, {-1, 0}, {-1, 2}, {0, 2}}},
-        {Type::J, {{0, 1}, {0, 0}, {0, 2}, {-1, 2}}},
-        {Type::T, {{0, 0}, {-1, 1}, {0, 1}, {1, 1}}}
-    };
-    return coordsMap.at(type);
-}
+constexpr std::array<RotationSet, Shape::TypeCount> rotationTable = buildRotationTable();
 
-const std::vector<std::pair<int, int>>& Shape::getCoords() const {
-    return coords;
-}
-
-void Shape::moveDown() {
-    for (auto& coord : coords) {
-        coord.second += 1;
-    }
-}
-
-void Shape::moveLeft() {
-    for (const auto& coord : coords) {
-        if (coord.first - 1 < 0) return;
-    }
-    for (auto& coord : coords) {
-        coord.first -= 1;
-    }
-}
+struct Canonical { int rotation, dx, dy; };
 
-void Shape::moveRight(int boardWidth) {
-    for (const auto& coord : coords) {
-        if (coord.first + 1 >= boardWidth) return;
-    }
-    for (auto& coord : coords) {
-        coord.first += 1;
+constexpr Offset minCorner(const CellOffsets& cells) {
+    Offset m = cells[0];
+    for (const auto& c : cells) {
+        if (c.x < m.x) m.x = c.x;
+        if (c.y < m.y) m.y = c.y;
     }
+    return m;
 }
 
-void Shape::rotateClockwise(const std::vector<std::vector<int>>& board, int boardWidth, int boardHeight) {
-    if (type == Type::O) return;
-
-    std::vector<std::pair<int, int>> preRotationCoords = coords;
-    int oldRotationState = rotationState;
-
-    rotateShape(1);
-
-    if (isValidPosition(board, boardWidth, boardHeight)) return;
-
-    std::vector<std::pair<int, int>> rotatedCoords = coords;
-    std::vector<int> kickOffsets = {1, -1, 2, -2};
-
-    for (int dx : kickOffsets) {
-        for (size_t i = 0; i < coords.size(); ++i) {
-            coords[i].first = rotatedCoords[i].first + dx;
-        }
-        if (isValidPosition(board, boardWidth, boardHeight)) {
-            rotationState = (rotationState + 1) % 4;
-            return;
+// For each rotation, the lowest rotation index that covers the same cell
+// set, and the origin shift that lines the two up.
+constexpr std::array<std::array<Canonical, 4>, Shape::TypeCount> buildCanonicalTable() {
+    std::array<std::array<Canonical, 4>, Shape::TypeCount> table{};
+    for (int t = 0; t < Shape::TypeCount; ++t) {
+        for (int r = 0; r < 4; ++r) {
+            const Offset mr = minCorner(rotationTable[t][r]);
+            table[t][r] = { r, 0, 0 };
+            for (int c = 0; c < r; ++c) {
+                const Offset mc = minCorner(rotationTable[t][c]);
+                bool same = true;
+                for (const auto& a : rotationTable[t][r]) {
+                    bool found = false;
+                    for (const auto& b : rotationTable[t][c])
+                        found = found || (a.x - mr.x == b.x - mc.x && a.y - mr.y == b.y - mc.y);
+                    same = same && found;
+                }
+                if (same) { table[t][r] = { c, mr.x - mc.x, mr.y - mc.y }; break; }
+            }
         }
-        coords = rotatedCoords;
     }
-
-    coords = preRotationCoords;
-    rotationState = oldRotationState;
+    return table;
 }
 
-void Shape::rotateCounterClockwise(const std::vector<std::vector<int>>& board, int boardWidth, int boardHeight) {
-    if (type == Type::O) return;
-
-    std::vector<std::pair<int, int>> preRotationCoords = coords;
-    int oldRotationState = rotationState;
+constexpr std::array<std::array<Canonical, 4>, Shape::TypeCount> canonicalTable = buildCanonicalTable();
+constexpr std::array<int, 4> kickOffsets = {1, -1, 2, -2};
 
-    rotateShape(-1);
-
-    if (isValidPosition(board, boardWidth, boardHeight)) return;
+inline const CellOffsets& offsetsOf(Shape::Type type, int rotation) noexcept {
+    return rotationTable[static_cast<int>(type)][rotation];
+}
+}
 
-    std::vector<std::pair<int, int>> rotatedCoords = coords;
-    std::vector<int> kickOffsets = {1, -1, 2, -2};
+Shape::Shape(Type type, int startX, int startY)
+    : type(type), rotation(0),
+      originX(startX + spawnOffsets[static_cast<int>(type)][0].x),
+      originY(startY + spawnOffsets[static_cast<int>(type)][0].y) {}
 
-    for (int dx : kickOffsets) {
-        for (size_t i = 0; i < coords.size(); ++i) {
-            coords[i].first = rotatedCoords[i].first + dx;
-        }
-        if (isValidPosition(board, boardWidth, boardHeight)) {
-            rotationState = (rotationState + 3) % 4;
-            return;
-        }
-        coords = rotatedCoords;
+Shape::Coords Shape::getCoords() const noexcept {
+    const CellOffsets& offsets = offsetsOf(type, rotation);
+    Coords out;
+    for (int i = 0; i < 4; ++i) {
+        out[i] = { originX + offsets[i].x, originY + offsets[i].y };
     }
-
-    coords = preRotationCoords;
-    rotationState = oldRotationState;
+    return out;
 }
 
+Shape Shape::canonical() const noexcept {
+    const Canonical& c = canonicalTable[static_cast<int>(type)][rotation];
+    Shape out = *this;
+    out.rotation = c.rotation;
+    out.originX += c.dx;
+    out.originY += c.dy;
+    return out;
+}
 
-
-void Shape::rotateShape(int direction) {
-    auto pivot = coords[0];
-    for (auto& coord : coords) {
-        int x = coord.first - pivot.first;
-        int y = coord.second - pivot.second;
-        coord.first = pivot.first - direction * y;
-        coord.second = pivot.second + direction * x;
+void Shape::moveLeft() noexcept {
+    for (const auto& o : offsetsOf(type, rotation)) {
+        if (originX + o.x - 1 < 0) return;
     }
-    rotationState = (rotationState + direction + 4) % 4;
+    --originX;
 }
 
-bool Shape::isValidPosition(const std::vector<std::vector<int>>& board, int boardWidth, int boardHeight) const {
-    for (const auto& coord : coords) {
-        int x = coord.first;
-        int y = coord.second;
-
-        if (x < 0 || x >= boardWidth || y < 0 || y >= boardHeight) return false;
-        if (board[y][x] != 0) return false;
+void Shape::moveRight(int boardWidth) noexcept {
+    for (const auto& o : offsetsOf(type, rotation)) {
+        if (originX + o.x + 1 >= boardWidth) return;
     }
-    return true;
+    ++originX;
 }
 
-void Shape::draw(SDL_Renderer* renderer, int cellSize, int offsetX, int offsetY, bool isShadow) const {
-    const int gap = 1;
-    const int margin = 1;
-    const int borderThickness = 2;
-    const int radius = 6;
-
-    SDL_Color mainColor = color;
-    SDL_Color borderColor = darker(color, 0.55f);
-
-    for (const auto& coord : coords) {
-        int x = offsetX + coord.first * cellSize + gap;
-        int y = offsetY + coord.second * cellSize + gap;
-        int w = cellSize - 2 * gap;
-        int h = cellSize - 2 * gap;
-
-        if (isShadow) {
-            draw_smooth_rounded_rect(renderer, x, y, w, h, radius, mainColor, false, 3);
-        } else {
-            draw_tetris_cell(renderer, x, y, w, h, radius, margin, borderThickness, mainColor, borderColor);
-            draw_smooth_parabolic_highlight_arc(renderer, x, y, w, h, margin, borderThickness);
-        }
-    }
+void Shape::rotateClockwise(const Playfield& field) noexcept {
+    if (type == Type::O) return;
+    tryRotateTo(field, (rotation + 1) & 3);
 }
 
-Shape::Type Shape::getType() const {
-    return type;
+void Shape::rotateCounterClockwise(const Playfield& field) noexcept {
+    if (type == Type::O) return;
+    tryRotateTo(field, (rotation + 3) & 3);
 }
 
-void Shape::setPosition(int x, int y) {
-    int dx = x - coords[0].first;
-    int dy = y - coords[0].second;
+bool Shape::tryRotateTo(const Playfield& field, int nextRotation) noexcept {
+    const int prevRotation = rotation;
+    const int prevX        = originX;
 
-    for (auto& coord : coords) {
-        coord.first += dx;
-        coord.second += dy;
+    rotation = nextRotation;
+    if (isValidPosition(field)) return true;
+
+    for (int dx : kickOffsets) {
+        originX = prevX + dx;
+        if (isValidPosition(field)) return true;
     }
-}
 
-void Shape::resetRotation() {
-    const int pivotX = coords[0].first;
-    const int pivotY = coords[0].second;
+    originX  = prevX;
+    rotation = prevRotation;
+    return false;
+}
 
-    const auto& defaultCoords = getDefaultCoordsForType(type);
+bool Shape::isValidPosition(const Playfield& field) const noexcept {
+    const int boardWidth  = field.getCols();
+    const int boardHeight = field.getRows();
+    for (const auto& o : offsetsOf(type, rotation)) {
+        const int x = originX + o.x;
+        const int y = originY + o.y;
 
-    coords.clear();
-    for (const auto& dc : defaultCoords) {
-        coords.emplace_back(pivotX + dc.first, pivotY + dc.second);
+        if (x < 0 || x >= boardWidth || y < 0 || y >= boardHeight) return false;
+        if (field.isCellFilled(x, y)) return false;
     }
-
-    rotationState = 0;
+    return true;
 }
 
 void Shape::getLocalCoords(std::vector<std::pair<int,int>>& out) const {
     out.clear();
-    if (coords.empty()) return;
-
-    int originX = coords[0].first;
-    int originY = coords[0].second;
-
-    for (const auto& c : coords) {
-        out.emplace_back(c.first - originX, c.second - originY);
+    for (const auto& o : offsetsOf(type, rotation)) {
+        out.emplace_back(o.x, o.y);
     }
 }
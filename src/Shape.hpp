@@ -1,41 +1,54 @@
 #pragma once
+#include <array>
+#include <cstdint>
+#include <utility>
 #include <vector>
-#include <SDL2/SDL.h>
-#include <unordered_map>
-#include "DrawUtils.hpp"
+
+class Playfield;
 
 class Shape {
 public:
     enum class Type { O, I, S, Z, L, J, T };
 
-    std::vector<std::pair<int, int>> coords;
+    using Coords = std::array<std::pair<int, int>, 4>;
 
-    Shape(Type type, int startX, int startY, SDL_Color color);
+    static constexpr int TypeCount   = 7;
+    static constexpr int PaletteSize = 8;
 
-    void moveDown();
-    void moveLeft();
-    void moveRight(int boardWidth);
+    Shape(Type type, int startX, int startY);
 
-    void rotateClockwise(const std::vector<std::vector<int>>& board, int boardWidth, int boardHeight);
-    void rotateCounterClockwise(const std::vector<std::vector<int>>& board, int boardWidth, int boardHeight);
+    void moveDown() noexcept { ++originY; }
+    void moveLeft() noexcept;
+    void moveRight(int boardWidth) noexcept;
+    void translate(int dx, int dy) noexcept { originX += dx; originY += dy; }
 
-    const std::vector<std::pair<int, int>>& getCoords() const;
-    SDL_Color getColor() const { return color; }
+    void rotateClockwise(const Playfield& field) noexcept;
+    void rotateCounterClockwise(const Playfield& field) noexcept;
 
-    void draw(SDL_Renderer* renderer, int cellSize, int offsetX = 0, int offsetY = 0, bool isShadow = false) const;
-    Type getType() const;
+    Coords  getCoords() const noexcept;
+    uint8_t getColorIndex() const noexcept { return static_cast<uint8_t>(type) + 1; }
 
-    void setPosition(int x, int y);
-    void getLocalCoords(std::vector<std::pair<int,int>>& out) const;
+    Type getType() const noexcept     { return type; }
+    int  getRotation() const noexcept { return rotation; }
+    int  getOriginX() const noexcept  { return originX; }
+    int  getOriginY() const noexcept  { return originY; }
 
-    int rotationState;
+    void setPosition(int x, int y) noexcept { originX = x; originY = y; }
+    void setRotation(int r) noexcept        { rotation = r & 3; }
+    Shape canonical() const noexcept;
+
+    bool operator==(const Shape& o) const noexcept {
+        return type == o.type && rotation == o.rotation && originX == o.originX && originY == o.originY;
+    }
+    bool operator!=(const Shape& o) const noexcept { return !(*this == o); }
+    void getLocalCoords(std::vector<std::pair<int,int>>& out) const;
 
 private:
     Type type;
-    SDL_Color color;
+    int  rotation;
+    int  originX;
+    int  originY;
 
-    void rotateShape(int direction);
-    bool isValidPosition(const std::vector<std::vector<int>>& board, int boardWidth, int boardHeight) const;
-    static const std::vector<std::pair<int, int>>& getDefaultCoordsForType(Type type);
-    void resetRotation();
+    bool tryRotateTo(const Playfield& field, int nextRotation) noexcept;
+    bool isValidPosition(const Playfield& field) const noexcept;
 };
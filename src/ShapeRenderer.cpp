@@ -0,0 +1,102 @@
+#include "ShapeRenderer.hpp"
+#include "DrawUtils.hpp"
+
+#include <unordered_map>
+
+namespace {
+constexpr int Gap             = 1;
+constexpr int Margin          = 1;
+constexpr int BorderThickness = 2;
+constexpr int Radius          = 6;
+
+struct CellCache {
+    SDL_Renderer*                              renderer = nullptr;
+    std::unordered_map<uint32_t, SDL_Texture*> textures;
+};
+
+CellCache& cellCache() {
+    static CellCache cache;
+    return cache;
+}
+}
+
+SDL_Color ShapeRenderer::paletteColor(uint8_t index) noexcept {
+    static constexpr SDL_Color palette[Shape::PaletteSize] = {
+        {0, 0, 0, 0},
+        {255, 215, 0, 255},
+        {0, 255, 255, 255},
+        {0, 255, 0, 255},
+        {255, 0, 0, 255},
+        {255, 140, 0, 255},
+        {0, 0, 255, 255},
+        {128, 0, 128, 255}
+    };
+    return palette[index < Shape::PaletteSize ? index : 0];
+}
+
+void ShapeRenderer::draw(SDL_Renderer* renderer, const Shape& shape, int cellSize,
+                         int offsetX, int offsetY, bool isShadow) {
+    const int size = cellSize - 2 * Gap;
+    if (size <= 0) return;
+
+    SDL_Texture* tex = cellTexture(renderer, shape.getColorIndex(), cellSize, isShadow);
+    for (const auto& coord : shape.getCoords()) {
+        int x = offsetX + coord.first * cellSize + Gap;
+        int y = offsetY + coord.second * cellSize + Gap;
+
+        if (tex) {
+            SDL_Rect dst{ x, y, size, size };
+            SDL_RenderCopy(renderer, tex, nullptr, &dst);
+        } else {
+            drawCell(renderer, colorOf(shape), x, y, size, isShadow);
+        }
+    }
+}
+
+void ShapeRenderer::clearCache() {
+    CellCache& cache = cellCache();
+    for (auto& [key, tex] : cache.textures) SDL_DestroyTexture(tex);
+    cache.textures.clear();
+    cache.renderer = nullptr;
+}
+
+SDL_Texture* ShapeRenderer::cellTexture(SDL_Renderer* renderer, uint8_t colorIndex, int cellSize, bool isShadow) {
+    CellCache& cache = cellCache();
+    if (cache.renderer != renderer) {
+        clearCache();
+        cache.renderer = renderer;
+    }
+
+    const uint32_t key = uint32_t(colorIndex) | uint32_t(cellSize & 0x7FFF) << 8 | uint32_t(isShadow) << 23;
+    if (auto it = cache.textures.find(key); it != cache.textures.end()) return it->second;
+
+    const int size = cellSize - 2 * Gap;
+    SDL_Texture* tex = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, size, size);
+    if (!tex) {
+        SDL_Log("Failed to create cell texture: %s", SDL_GetError());
+        return nullptr;
+    }
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+
+    SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+    if (SDL_SetRenderTarget(renderer, tex) != 0) {
+        SDL_DestroyTexture(tex);
+        return nullptr;
+    }
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+    drawCell(renderer, paletteColor(colorIndex), 0, 0, size, isShadow);
+    SDL_SetRenderTarget(renderer, previousTarget);
+
+    cache.textures.emplace(key, tex);
+    return tex;
+}
+
+void ShapeRenderer::drawCell(SDL_Renderer* renderer, SDL_Color color, int x, int y, int size, bool isShadow) {
+    if (isShadow) {
+        draw_smooth_rounded_rect(renderer, x, y, size, size, Radius, color, false, 3);
+    } else {
+        draw_tetris_cell(renderer, x, y, size, size, Radius, Margin, BorderThickness, color, darker(color, 0.55f));
+        draw_smooth_parabolic_highlight_arc(renderer, x, y, size, size, Margin, BorderThickness);
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+#include "Shape.hpp"
+
+class ShapeRenderer {
+public:
+    static SDL_Color paletteColor(uint8_t index) noexcept;
+    static SDL_Color colorOf(const Shape& shape) noexcept { return paletteColor(shape.getColorIndex()); }
+
+    // Cells are rasterized once per (colour, cell size, outline) into a
+    // cached texture and copied from then on.
+    static void draw(SDL_Renderer* renderer, const Shape& shape, int cellSize,
+                     int offsetX = 0, int offsetY = 0, bool isShadow = false);
+    // Destroys the cached cell textures; call before the renderer goes away.
+    static void clearCache();
+
+private:
+    static SDL_Texture* cellTexture(SDL_Renderer* renderer, uint8_t colorIndex, int cellSize, bool isShadow);
+    static void drawCell(SDL_Renderer* renderer, SDL_Color color, int x, int y, int size, bool isShadow);
+};
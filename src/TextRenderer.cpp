@@ -0,0 +1,171 @@
+#include "TextRenderer.hpp"
+
+#include <algorithm>
+
+TextRenderer::TextRenderer(SDL_Renderer* renderer) : renderer(renderer) {}
+
+TextRenderer::~TextRenderer() {
+    clear();
+}
+
+void TextRenderer::clear() {
+    for (auto& [font, atlas] : atlases) {
+        if (atlas.texture) SDL_DestroyTexture(atlas.texture);
+    }
+    atlases.clear();
+    for (auto& [style, set] : labels) {
+        for (auto& [text, label] : set) {
+            if (label.texture) SDL_DestroyTexture(label.texture);
+        }
+    }
+    labels.clear();
+}
+
+const TextRenderer::Glyph& TextRenderer::glyphOf(const Atlas& atlas, unsigned char c) noexcept {
+    if (c < FirstGlyph || c > LastGlyph) c = '?';
+    return atlas.glyphs[c - FirstGlyph];
+}
+
+const TextRenderer::Atlas* TextRenderer::atlasFor(TTF_Font* font) {
+    if (!font) return nullptr;
+    if (auto it = atlases.find(font); it != atlases.end()) {
+        return it->second.texture ? &it->second : nullptr;
+    }
+
+    // A failed build stays in the map so it is not retried every frame.
+    Atlas& atlas = atlases[font];
+    atlas.lineHeight = TTF_FontHeight(font);
+
+    constexpr int MaxWidth = 1024;
+    constexpr int Pad      = 1;
+    const SDL_Color white{255, 255, 255, 255};
+
+    std::array<SDL_Surface*, GlyphCount> surfaces{};
+    int penX = Pad, penY = Pad, rowHeight = 0, width = 0;
+    for (int i = 0; i < GlyphCount; ++i) {
+        const Uint16 ch = Uint16(FirstGlyph + i);
+        Glyph& g = atlas.glyphs[i];
+
+        int minx = 0, maxx = 0, miny = 0, maxy = 0, advance = 0;
+        if (TTF_GlyphMetrics(font, ch, &minx, &maxx, &miny, &maxy, &advance) == 0) {
+            g.advance = advance;
+            g.offsetX = std::min(0, minx);
+        }
+        if (ch == ' ') continue;
+
+        SDL_Surface* s = TTF_RenderGlyph_Blended(font, ch, white);
+        if (!s) continue;
+        surfaces[i] = s;
+        if (penX + s->w + Pad > MaxWidth) {
+            penX = Pad;
+            penY += rowHeight + Pad;
+            rowHeight = 0;
+        }
+        g.src = {penX, penY, s->w, s->h};
+        penX += s->w + Pad;
+        rowHeight = std::max(rowHeight, s->h);
+        width = std::max(width, penX);
+    }
+    atlas.width  = std::max(width, 1);
+    atlas.height = penY + rowHeight + Pad;
+
+    if (SDL_Surface* sheet = SDL_CreateRGBSurfaceWithFormat(0, atlas.width, atlas.height, 32,
+                                                            SDL_PIXELFORMAT_RGBA32)) {
+        for (int i = 0; i < GlyphCount; ++i) {
+            if (!surfaces[i]) continue;
+            SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dst = atlas.glyphs[i].src;
+            SDL_BlitSurface(surfaces[i], nullptr, sheet, &dst);
+        }
+        atlas.texture = SDL_CreateTextureFromSurface(renderer, sheet);
+        if (atlas.texture) SDL_SetTextureBlendMode(atlas.texture, SDL_BLENDMODE_BLEND);
+        SDL_FreeSurface(sheet);
+    }
+    for (SDL_Surface* s : surfaces) {
+        if (s) SDL_FreeSurface(s);
+    }
+
+    if (!atlas.texture) {
+        SDL_Log("Failed to build glyph atlas: %s", SDL_GetError());
+        return nullptr;
+    }
+    return &atlas;
+}
+
+SDL_Point TextRenderer::measure(TTF_Font* font, const std::string& text) {
+    const Atlas* atlas = atlasFor(font);
+    if (!atlas) return {0, 0};
+
+    int w = 0;
+    for (unsigned char c : text) w += glyphOf(*atlas, c).advance;
+    return {w, atlas->lineHeight};
+}
+
+void TextRenderer::draw(TTF_Font* font, const std::string& text, int x, int y, SDL_Color color, float scale) {
+    const Atlas* atlas = atlasFor(font);
+    if (!atlas || text.empty()) return;
+
+    verts.clear();
+    indices.clear();
+    float penX = float(x);
+    for (unsigned char c : text) {
+        const Glyph& g = glyphOf(*atlas, c);
+        if (g.src.w > 0) {
+            const float x0 = penX + g.offsetX * scale;
+            const float y0 = float(y);
+            const float x1 = x0 + g.src.w * scale;
+            const float y1 = y0 + g.src.h * scale;
+            const float u0 = float(g.src.x) / atlas->width;
+            const float v0 = float(g.src.y) / atlas->height;
+            const float u1 = float(g.src.x + g.src.w) / atlas->width;
+            const float v1 = float(g.src.y + g.src.h) / atlas->height;
+
+            const int base = (int)verts.size();
+            verts.push_back({{x0, y0}, color, {u0, v0}});
+            verts.push_back({{x1, y0}, color, {u1, v0}});
+            verts.push_back({{x1, y1}, color, {u1, v1}});
+            verts.push_back({{x0, y1}, color, {u0, v1}});
+            for (int i : {0, 1, 2, 0, 2, 3}) indices.push_back(base + i);
+        }
+        penX += g.advance * scale;
+    }
+
+    if (!indices.empty()) {
+        SDL_RenderGeometry(renderer, atlas->texture, verts.data(), (int)verts.size(),
+                           indices.data(), (int)indices.size());
+    }
+}
+
+void TextRenderer::drawCentered(TTF_Font* font, const std::string& text, int cx, int cy, SDL_Color color,
+                                float scale) {
+    const SDL_Point size = measure(font, text);
+    const int w = static_cast<int>(size.x * scale);
+    const int h = static_cast<int>(size.y * scale);
+    draw(font, text, cx - w / 2, cy - h / 2, color, scale);
+}
+
+SDL_Texture* TextRenderer::label(TTF_Font* font, const std::string& text, SDL_Color color, int* w, int* h) {
+    if (!font || text.empty()) return nullptr;
+
+    const Uint32 packed = Uint32(color.r) << 24 | Uint32(color.g) << 16 | Uint32(color.b) << 8 | color.a;
+    LabelSet& set = labels[LabelStyle{font, packed}];
+    auto it = set.find(text);
+    if (it == set.end()) {
+        Label entry;
+        if (SDL_Surface* surf = TTF_RenderText_Blended(font, text.c_str(), color)) {
+            entry.texture = SDL_CreateTextureFromSurface(renderer, surf);
+            entry.w = surf->w;
+            entry.h = surf->h;
+            SDL_FreeSurface(surf);
+        }
+        it = set.emplace(text, entry).first;
+    }
+
+    if (w) *w = it->second.w;
+    if (h) *h = it->second.h;
+    return it->second.texture;
+}
+
+void TextRenderer::prewarm(TTF_Font* font) {
+    (void)atlasFor(font);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Draws text from glyph atlases baked once per font, so a string costs one
+// geometry call rather than a rasterize plus a texture upload. Static
+// labels can instead be baked whole with label(), which keeps SDL_ttf's
+// kerning. Fonts must stay open for as long as the renderer is used.
+class TextRenderer {
+public:
+    explicit TextRenderer(SDL_Renderer* renderer);
+    ~TextRenderer();
+
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+
+    // Size of `text` in pixels at scale 1.
+    SDL_Point measure(TTF_Font* font, const std::string& text);
+    void draw(TTF_Font* font, const std::string& text, int x, int y, SDL_Color color, float scale = 1.0f);
+    void drawCentered(TTF_Font* font, const std::string& text, int cx, int cy, SDL_Color color,
+                      float scale = 1.0f);
+
+    // Whole-string texture cached by font, text and colour.
+    SDL_Texture* label(TTF_Font* font, const std::string& text, SDL_Color color,
+                       int* w = nullptr, int* h = nullptr);
+
+    void prewarm(TTF_Font* font);
+    void clear();
+
+private:
+    static constexpr int FirstGlyph = 32;
+    static constexpr int LastGlyph  = 126;
+    static constexpr int GlyphCount = LastGlyph - FirstGlyph + 1;
+
+    struct Glyph {
+        SDL_Rect src{0, 0, 0, 0};
+        int      offsetX = 0;
+        int      advance = 0;
+    };
+    struct Atlas {
+        SDL_Texture*                     texture    = nullptr;
+        int                              width      = 0;
+        int                              height     = 0;
+        int                              lineHeight = 0;
+        std::array<Glyph, GlyphCount>    glyphs{};
+    };
+    struct Label {
+        SDL_Texture* texture = nullptr;
+        int          w = 0, h = 0;
+    };
+    // Labels are grouped by font and colour so a lookup hashes the
+    // caller's string as is instead of building a combined key.
+    struct LabelStyle {
+        TTF_Font* font;
+        Uint32    color;
+
+        bool operator==(const LabelStyle& o) const noexcept { return font == o.font && color == o.color; }
+    };
+    struct LabelStyleHash {
+        size_t operator()(const LabelStyle& s) const noexcept {
+            return std::hash<TTF_Font*>()(s.font) ^ (size_t(s.color) * 0x9E3779B97F4A7C15ull);
+        }
+    };
+    using LabelSet = std::unordered_map<std::string, Label>;
+
+    SDL_Renderer*                          renderer;
+    std::unordered_map<TTF_Font*, Atlas>   atlases;
+    std::unordered_map<LabelStyle, LabelSet, LabelStyleHash> labels;
+    std::vector<SDL_Vertex>                verts;
+    std::vector<int>                       indices;
+
+    const Atlas* atlasFor(TTF_Font* font);
+    static const Glyph& glyphOf(const Atlas& atlas, unsigned char c) noexcept;
+};
@@ -0,0 +1,86 @@
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+WorkerPool::WorkerPool(int extraThreads) {
+    for (int i = 0; i < extraThreads; ++i) {
+        threads.emplace_back([this] { workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& t : threads) t.join();
+}
+
+int WorkerPool::defaultExtraThreads() noexcept {
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+}
+
+void WorkerPool::drain(const std::function<void(int)>& fn, int chunks) {
+    try {
+        for (int c = nextChunk++; c < chunks; c = nextChunk++) {
+            fn(c);
+        }
+    } catch (...) {
+        nextChunk = chunks;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failure) failure = std::current_exception();
+    }
+}
+
+void WorkerPool::run(int chunks, const std::function<void(int)>& fn) {
+    if (chunks <= 0) return;
+    if (threads.empty() || chunks == 1) {
+        for (int c = 0; c < chunks; ++c) fn(c);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job        = &fn;
+        chunkCount = chunks;
+        nextChunk  = 0;
+        finished   = 0;
+        failure    = nullptr;
+        ++generation;
+    }
+    wake.notify_all();
+
+    drain(fn, chunks);
+
+    // Every worker must check in before `fn` goes out of scope.
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return finished == static_cast<int>(threads.size()); });
+    job = nullptr;
+    if (failure) std::rethrow_exception(std::exchange(failure, nullptr));
+}
+
+void WorkerPool::workerLoop() {
+    uint64_t seen = 0;
+    for (;;) {
+        const std::function<void(int)>* fn = nullptr;
+        int chunks = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen   = generation;
+            fn     = job;
+            chunks = chunkCount;
+        }
+
+        drain(*fn, chunks);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++finished;
+        }
+        done.notify_one();
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of threads that split an indexed job into chunks. The calling
+// thread works on the job too, and run() returns only once every chunk is
+// done. A pool serves one caller at a time. If a chunk throws, the chunks
+// not yet started are skipped and run() rethrows the first exception once
+// every thread has let go of the job.
+class WorkerPool {
+public:
+    explicit WorkerPool(int extraThreads = defaultExtraThreads());
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const noexcept { return static_cast<int>(threads.size()) + 1; }
+
+    void run(int chunks, const std::function<void(int)>& job);
+
+    static int defaultExtraThreads() noexcept;
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex               mutex;
+    std::condition_variable  wake;
+    std::condition_variable  done;
+
+    const std::function<void(int)>* job = nullptr;
+    int              chunkCount = 0;
+    std::atomic<int> nextChunk{0};
+    uint64_t         generation = 0;
+    int              finished   = 0;
+    bool             stopping   = false;
+    std::exception_ptr failure;
+
+    void workerLoop();
+    void drain(const std::function<void(int)>& fn, int chunks);
+};
@@ -0,0 +1,410 @@
+// Micro-benchmarks for the per-frame paths of the core: board queries,
+// line clears, rotation and the placement planner, over a fixed corpus of
+// seeded boards. Prints JSON with ns/op and allocations/op.
+#include "Board.hpp"
+#include "FeatureKernel.hpp"
+#include "Planner.hpp"
+#include "Playfield.hpp"
+#include "Shape.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+uint64_t allocationCount = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+constexpr int Rows = 20;
+constexpr int Cols = 10;
+
+volatile long sink = 0;
+
+struct Options {
+    uint32_t seed      = 1;
+    int      boards    = 8;
+    double   minTimeMs = 200.0;
+    std::string filter;
+};
+
+struct Corpus {
+    std::string        name;
+    std::vector<Board> boards;
+    std::vector<Board> clearing;  // boards caught mid line-clear
+};
+
+struct Result {
+    std::string name;
+    std::string corpus;
+    uint64_t    ops;
+    double      nsPerOp;
+    double      allocsPerOp;
+};
+
+int maxHeight(const Board& board) {
+    const Playfield& field = board.getPlayfield();
+    int top = field.getRows();
+    for (int x = 0; x < field.getCols(); ++x) top = std::min(top, field.getColumnTop(x));
+    return field.getRows() - top;
+}
+
+Shape::Type randomType(std::mt19937& rng) {
+    return static_cast<Shape::Type>(std::uniform_int_distribution<int>(0, Shape::TypeCount - 1)(rng));
+}
+
+// Random reachable placements build ragged stacks with holes, which is a
+// harsher input than the planner's own tidy play.
+Board makeBoard(uint32_t seed, int minHeight, Planner& planner) {
+    std::mt19937 rng(seed);
+    Board board(Rows, Cols);
+    std::vector<Shape> locks;
+    for (int tries = 0; maxHeight(board) < minHeight && tries < 1000; ++tries) {
+        Shape s(randomType(rng), Cols / 2, 0);
+        if (board.isOccupied(s, 0, 0)) break;
+        planner.computeReachableLocks(board, s, locks);
+        if (locks.empty()) break;
+        board.placeShape(locks[rng() % locks.size()]);
+        if (board.clearFullLines() > 0) board.finalizeLineClear();
+    }
+    return board;
+}
+
+bool findClearingBoard(const Board& board, Planner& planner, Board& out) {
+    std::vector<Shape> locks;
+    for (int t = 0; t < Shape::TypeCount; ++t) {
+        Shape s(static_cast<Shape::Type>(t), Cols / 2, 0);
+        if (board.isOccupied(s, 0, 0)) continue;
+        planner.computeReachableLocks(board, s, locks);
+        for (const Shape& lock : locks) {
+            Board candidate = board;
+            candidate.placeShape(lock);
+            if (candidate.clearFullLines() > 0) {
+                out = candidate;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<Corpus> buildCorpus(const Options& opt) {
+    Planner planner;
+    std::vector<Corpus> corpus = {{"empty", {}, {}}, {"mid", {}, {}}, {"topout", {}, {}}};
+    const int minHeights[] = {0, Rows / 2, Rows - 4};
+
+    for (size_t c = 0; c < corpus.size(); ++c) {
+        for (int i = 0; i < opt.boards; ++i) {
+            const uint32_t seed = opt.seed * 7919u + uint32_t(c * 1000 + i);
+            corpus[c].boards.push_back(makeBoard(seed, minHeights[c], planner));
+
+            Board clearing(Rows, Cols);
+            if (findClearingBoard(corpus[c].boards.back(), planner, clearing))
+                corpus[c].clearing.push_back(clearing);
+        }
+    }
+    return corpus;
+}
+
+std::vector<Shape> spawnShapes() {
+    std::vector<Shape> shapes;
+    for (int t = 0; t < Shape::TypeCount; ++t)
+        shapes.emplace_back(static_cast<Shape::Type>(t), Cols / 2, 0);
+    return shapes;
+}
+
+// Every type and rotation at every column, a few rows down the well.
+std::vector<Shape> probeShapes() {
+    std::vector<Shape> shapes;
+    for (int t = 0; t < Shape::TypeCount; ++t)
+        for (int r = 0; r < 4; ++r)
+            for (int x = 0; x < Cols; ++x)
+                for (int y = 2; y < Rows; y += 4) {
+                    Shape s(static_cast<Shape::Type>(t), 0, 0);
+                    s.setRotation(r);
+                    s.setPosition(x, y);
+                    shapes.push_back(s);
+                }
+    return shapes;
+}
+
+class Runner {
+public:
+    explicit Runner(const Options& opt) : opt(opt) {}
+
+    // `setup` runs untimed before each batch; `batch` returns the number of
+    // operations it performed.
+    void run(const std::string& name, const std::string& corpus,
+             const std::function<void()>& setup, const std::function<long()>& batch) {
+        if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) return;
+
+        setup();
+        batch();
+
+        using Clock = std::chrono::steady_clock;
+        Clock::duration elapsed{};
+        uint64_t ops = 0, allocs = 0;
+        while (std::chrono::duration<double, std::milli>(elapsed).count() < opt.minTimeMs) {
+            setup();
+            const uint64_t allocsBefore = allocationCount;
+            const auto start = Clock::now();
+            const long n = batch();
+            elapsed += Clock::now() - start;
+            allocs  += allocationCount - allocsBefore;
+            ops     += uint64_t(std::max(n, 1L));
+        }
+
+        const double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        results.push_back({name, corpus, ops, ns / double(ops), double(allocs) / double(ops)});
+    }
+
+    void printJson() const {
+        std::printf("{\n  \"benchmarks\": [\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            std::printf("    {\"name\": \"%s\", \"corpus\": \"%s\", \"ops\": %llu, "
+                        "\"ns_per_op\": %.2f, \"allocs_per_op\": %.3f}%s\n",
+                        r.name.c_str(), r.corpus.c_str(), static_cast<unsigned long long>(r.ops),
+                        r.nsPerOp, r.allocsPerOp, i + 1 < results.size() ? "," : "");
+        }
+        std::printf("  ]\n}\n");
+    }
+
+private:
+    const Options&      opt;
+    std::vector<Result> results;
+};
+
+Options parseOptions(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--seed")             opt.seed      = uint32_t(std::stoul(value()));
+        else if (arg == "--boards")      opt.boards    = std::stoi(value());
+        else if (arg == "--min-time-ms") opt.minTimeMs = std::stod(value());
+        else if (arg == "--filter")      opt.filter    = value();
+        else if (arg == "--help" || arg == "-h") {
+            std::cout << "usage: tetris-bench [--seed S] [--boards N] [--min-time-ms T] [--filter NAME]\n";
+            std::exit(0);
+        }
+        else throw std::invalid_argument("unknown option " + arg);
+    }
+    if (opt.boards <= 0) throw std::invalid_argument("--boards must be positive");
+    return opt;
+}
+
+void runSuite(Runner& runner, const Corpus& corpus) {
+    const std::vector<Shape> probes = probeShapes();
+    const std::vector<Shape> spawns = spawnShapes();
+    const std::vector<Board>& boards = corpus.boards;
+    auto noSetup = [] {};
+
+    runner.run("Board::isOccupied", corpus.name, noSetup, [&] {
+        long hits = 0, ops = 0;
+        for (const Board& b : boards)
+            for (const Shape& s : probes) { hits += b.isOccupied(s, 0, 1); ++ops; }
+        sink = sink + hits;
+        return ops;
+    });
+
+    runner.run("Board::dropDistance", corpus.name, noSetup, [&] {
+        long rows = 0, ops = 0;
+        for (const Board& b : boards)
+            for (const Shape& s : probes) {
+                if (b.isOccupied(s, 0, 0)) continue;
+                rows += b.dropDistance(s);
+                ++ops;
+            }
+        sink = sink + rows;
+        return ops;
+    });
+
+    runner.run("Board::countHoles", corpus.name, noSetup, [&] {
+        long holes = 0;
+        for (int rep = 0; rep < 64; ++rep)
+            for (const Board& b : boards) holes += b.countHoles();
+        sink = sink + holes;
+        return long(boards.size()) * 64;
+    });
+
+    runner.run("Shape::rotateClockwise", corpus.name, noSetup, [&] {
+        long ops = 0;
+        for (const Board& b : boards)
+            for (const Shape& s : probes) {
+                Shape r = s;
+                r.rotateClockwise(b.getPlayfield());
+                sink = sink + r.getRotation();
+                ++ops;
+            }
+        return ops;
+    });
+
+    // Most locks clear nothing, so the scan runs over every board, plus the
+    // ones that do have full rows.
+    std::vector<Board> scanned = boards;
+    scanned.insert(scanned.end(), corpus.clearing.begin(), corpus.clearing.end());
+    runner.run("Board::clearFullLines", corpus.name, noSetup, [&] {
+        long lines = 0;
+        for (int rep = 0; rep < 16; ++rep)
+            for (Board& b : scanned) lines += b.clearFullLines();
+        sink = sink + lines;
+        return long(scanned.size()) * 16;
+    });
+
+    if (!corpus.clearing.empty()) {
+        std::vector<Board> scratch;
+        scratch.reserve(corpus.clearing.size() * 16);
+        auto refill = [&] {
+            scratch.clear();
+            for (int rep = 0; rep < 16; ++rep)
+                scratch.insert(scratch.end(), corpus.clearing.begin(), corpus.clearing.end());
+        };
+
+        runner.run("Board::finalizeLineClear", corpus.name, refill, [&] {
+            for (Board& b : scratch) b.finalizeLineClear();
+            return long(scratch.size());
+        });
+    }
+
+    Planner planner;
+    std::vector<Shape> locks;
+
+    runner.run("Planner::computeReachableLocks", corpus.name, noSetup, [&] {
+        long ops = 0;
+        for (const Board& b : boards)
+            for (const Shape& s : spawns) {
+                if (b.isOccupied(s, 0, 0)) continue;
+                planner.computeReachableLocks(b, s, locks);
+                sink = sink + long(locks.size());
+                ++ops;
+            }
+        return ops;
+    });
+
+    std::vector<std::pair<size_t, Shape>> placements;
+    for (size_t i = 0; i < boards.size(); ++i)
+        for (const Shape& s : spawns) {
+            if (boards[i].isOccupied(s, 0, 0)) continue;
+            planner.computeReachableLocks(boards[i], s, locks);
+            for (const Shape& lock : locks) placements.emplace_back(i, lock);
+        }
+
+    // Placements are grouped by board, so consecutive locks share a field.
+    std::vector<Shape> placedLocks;
+    for (const auto& [i, lock] : placements) placedLocks.push_back(lock);
+    std::vector<FeatureKernel::Features> features(placedLocks.size());
+
+    // A corpus where every spawn is blocked has nothing to evaluate.
+    if (!placements.empty()) {
+        runner.run("FeatureKernel::evaluate", corpus.name, noSetup, [&] {
+            for (size_t k = 0; k < placements.size(); ++k)
+                features[k] = FeatureKernel::evaluate(boards[placements[k].first].getPlayfield(), placedLocks[k]);
+            sink = sink + features.back().contacts;
+            return long(placements.size());
+        });
+
+        runner.run("FeatureKernel::evaluate/batch", corpus.name, noSetup, [&] {
+            for (size_t k = 0; k < placements.size();) {
+                size_t end = k;
+                while (end < placements.size() && placements[end].first == placements[k].first) ++end;
+                FeatureKernel::evaluate(boards[placements[k].first].getPlayfield(), &placedLocks[k], int(end - k), &features[k]);
+                k = end;
+            }
+            sink = sink + features.back().contacts;
+            return long(placements.size());
+        });
+    }
+
+    runner.run("Planner::scorePlacement", corpus.name, noSetup, [&] {
+        long total = 0;
+        int  target = 0;
+        for (const auto& [i, lock] : placements) {
+            total += planner.scorePlacement(boards[i], lock, target % Cols, Rows - 1 - target % 4);
+            ++target;
+        }
+        sink = sink + total;
+        return long(placements.size());
+    });
+
+    runner.run("Planner::autoRotateCurrentShape", corpus.name, noSetup, [&] {
+        long ops = 0;
+        for (const Board& b : boards)
+            for (const Shape& s : spawns) {
+                if (b.isOccupied(s, 0, 0)) continue;
+                Shape shape = s;
+                planner.autoRotateCurrentShape(b, shape, int(ops % Cols), Rows - 1);
+                sink = sink + shape.getOriginX();
+                ++ops;
+            }
+        return ops;
+    });
+
+    // Hovering re-plans the same few cells over an unchanged board. The
+    // cold planner searches every time; the hover planner only rescores
+    // the target terms of its last lock set; the cached planner should
+    // answer these without searching.
+    Planner cold;
+    cold.reuseHoverSet = false;
+    Planner hover;
+    Planner cached;
+    cached.setCacheCapacity(boards.size() * spawns.size(), boards.size() * spawns.size() * 4);
+    const std::pair<const char*, Planner*> variants[] = {
+        {"Planner::planMousePlacement", &cold},
+        {"Planner::planMousePlacement/hover", &hover},
+        {"Planner::planMousePlacement/cached", &cached},
+    };
+    for (const auto& [name, p] : variants) {
+        runner.run(name, corpus.name, noSetup, [&, p = p] {
+            long ops = 0;
+            for (const Board& b : boards)
+                for (const Shape& s : spawns) {
+                    if (b.isOccupied(s, 0, 0)) continue;
+                    for (int cell = 0; cell < 4; ++cell) {
+                        auto lock = p->planMousePlacement(b, s, Cols / 2 + cell - 2, Rows - 1 - cell);
+                        sink = sink + (lock ? lock->getOriginX() : 0);
+                        ++ops;
+                    }
+                }
+            return ops;
+        });
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const Options opt = parseOptions(argc, argv);
+        const std::vector<Corpus> corpus = buildCorpus(opt);
+
+        Runner runner(opt);
+        for (const Corpus& c : corpus) runSuite(runner, c);
+        runner.printJson();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
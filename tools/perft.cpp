@@ -0,0 +1,216 @@
+// Move-generation verifier in the style of chess "perft": walks every
+// reachable lock of every piece through a seeded piece queue and counts
+// the leaves per depth. The counts and order-independent checksums are an
+// oracle for rewrites of Planner::computeReachableLocks, and the timings
+// are its throughput benchmark.
+#include "Board.hpp"
+#include "Planner.hpp"
+#include "Shape.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int      positions   = 16;
+    int      depth       = 3;
+    uint32_t seed        = 1;
+    int      rows        = 20;
+    int      cols        = 10;
+    bool     perPosition = false;
+};
+
+struct Position {
+    Board                    board{1, 1};
+    std::vector<Shape::Type> queue;
+};
+
+struct Tally {
+    uint64_t leaves     = 0;
+    uint64_t checksum   = 0;
+    uint64_t invalid    = 0;   // locks that overlap the stack or could fall further
+    uint64_t duplicates = 0;   // the same cells returned twice for one piece
+
+    void add(const Tally& o) noexcept {
+        leaves += o.leaves; checksum += o.checksum; invalid += o.invalid; duplicates += o.duplicates;
+    }
+};
+
+void printUsage() {
+    std::cout << "usage: tetris-perft [--positions N] [--depth N] [--seed S] [--rows N] [--cols N]\n"
+                 "                    [--per-position]\n"
+                 "  Depth 1 counts the locks of the first queued piece; each further depth\n"
+                 "  places every lock, clears lines and expands the next piece.\n";
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&]() -> long {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            return std::stol(argv[++i]);
+        };
+        if (arg == "--positions")          opt.positions   = int(value());
+        else if (arg == "--depth")         opt.depth       = int(value());
+        else if (arg == "--seed")          opt.seed        = uint32_t(value());
+        else if (arg == "--rows")          opt.rows        = int(value());
+        else if (arg == "--cols")          opt.cols        = int(value());
+        else if (arg == "--per-position")  opt.perPosition = true;
+        else if (arg == "--help" || arg == "-h") { printUsage(); std::exit(0); }
+        else throw std::invalid_argument("unknown option " + arg);
+    }
+    if (opt.positions <= 0 || opt.depth <= 0)
+        throw std::invalid_argument("--positions and --depth must be positive");
+    return opt;
+}
+
+uint64_t mix(uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+uint64_t cellsKey(const Shape& s) noexcept {
+    uint64_t key = 0;
+    for (const auto& [x, y] : s.getCoords()) key ^= Board::cellKey(x, y);
+    return key;
+}
+
+// Random reachable placements up to a random height, then a random queue.
+Position makePosition(const Options& opt, uint32_t seed, Planner& planner) {
+    std::mt19937 rng(seed);
+    auto randomType = [&] {
+        return static_cast<Shape::Type>(std::uniform_int_distribution<int>(0, Shape::TypeCount - 1)(rng));
+    };
+
+    Position pos;
+    pos.board = Board(opt.rows, opt.cols);
+    const int pieces = int(rng() % unsigned(opt.rows * opt.cols / 8 + 1));
+    std::vector<Shape> locks;
+    for (int i = 0; i < pieces; ++i) {
+        Shape s(randomType(), opt.cols / 2, 0);
+        if (pos.board.isOccupied(s, 0, 0)) break;
+        planner.computeReachableLocks(pos.board, s, locks);
+        if (locks.empty()) break;
+        // Pick from a canonical order, so the corpus does not depend on the
+        // order the generator under test returns its locks in.
+        std::sort(locks.begin(), locks.end(),
+                  [](const Shape& a, const Shape& b) { return cellsKey(a) < cellsKey(b); });
+        pos.board.placeShape(locks[rng() % locks.size()]);
+        if (pos.board.clearFullLines() > 0) pos.board.finalizeLineClear();
+    }
+    for (int i = 0; i < opt.depth; ++i) pos.queue.push_back(randomType());
+    return pos;
+}
+
+class Walker {
+public:
+    Walker(Planner& planner, const std::vector<Shape::Type>& queue, int depth)
+        : planner(planner), queue(queue), depth(depth), locks(depth), keys(depth) {}
+
+    Tally run(const Board& board) {
+        tally = {};
+        expand(board, 0);
+        return tally;
+    }
+
+private:
+    Planner&                           planner;
+    const std::vector<Shape::Type>&    queue;
+    int                                depth;
+    std::vector<std::vector<Shape>>    locks;   // one buffer per ply
+    std::vector<std::vector<uint64_t>> keys;
+    Tally                              tally;
+
+    void expand(const Board& board, int ply) {
+        Shape piece(queue[ply], board.getCols() / 2, 0);
+        if (board.isOccupied(piece, 0, 0)) return;
+
+        std::vector<Shape>& plyLocks = locks[ply];
+        planner.computeReachableLocks(board, piece, plyLocks);
+
+        if (ply + 1 == depth) {
+            std::vector<uint64_t>& plyKeys = keys[ply];
+            plyKeys.clear();
+            for (const Shape& lock : plyLocks) {
+                if (board.isOccupied(lock, 0, 0) || !board.isOccupied(lock, 0, 1)) ++tally.invalid;
+                const uint64_t key = cellsKey(lock);
+                plyKeys.push_back(key);
+                tally.checksum += mix(board.hash() ^ key);
+            }
+            std::sort(plyKeys.begin(), plyKeys.end());
+            tally.duplicates += uint64_t(plyKeys.end() - std::unique(plyKeys.begin(), plyKeys.end()));
+            tally.leaves += plyLocks.size();
+            return;
+        }
+
+        for (const Shape& lock : plyLocks) {
+            Board child = board;
+            child.placeShape(lock);
+            if (child.clearFullLines() > 0) child.finalizeLineClear();
+            expand(child, ply + 1);
+        }
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const Options opt = parseOptions(argc, argv);
+
+        Planner planner;
+        std::vector<Position> corpus;
+        for (int i = 0; i < opt.positions; ++i)
+            corpus.push_back(makePosition(opt, opt.seed + uint32_t(i), planner));
+
+        std::printf("perft          %d positions (seeds %u..%u), %dx%d\n", opt.positions, opt.seed,
+                    opt.seed + uint32_t(opt.positions - 1), opt.rows, opt.cols);
+
+        bool ok = true;
+        for (int depth = 1; depth <= opt.depth; ++depth) {
+            Tally total;
+            std::vector<Tally> perPosition(opt.positions);
+            const auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < opt.positions; ++i) {
+                Walker walker(planner, corpus[i].queue, depth);
+                perPosition[i] = walker.run(corpus[i].board);
+                total.add(perPosition[i]);
+            }
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            std::printf("depth %-2d %14llu locks  checksum %016llx  %9.3f s  %.0f locks/sec\n", depth,
+                        static_cast<unsigned long long>(total.leaves),
+                        static_cast<unsigned long long>(total.checksum), seconds,
+                        seconds > 0.0 ? double(total.leaves) / seconds : 0.0);
+            if (total.invalid || total.duplicates) {
+                std::printf("         %llu invalid, %llu duplicate locks\n",
+                            static_cast<unsigned long long>(total.invalid),
+                            static_cast<unsigned long long>(total.duplicates));
+                ok = false;
+            }
+            if (opt.perPosition && depth == opt.depth) {
+                for (int i = 0; i < opt.positions; ++i) {
+                    std::printf("  seed %-6u %14llu locks  checksum %016llx\n", opt.seed + uint32_t(i),
+                                static_cast<unsigned long long>(perPosition[i].leaves),
+                                static_cast<unsigned long long>(perPosition[i].checksum));
+                }
+            }
+        }
+        return ok ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,227 @@
+// Headless self-play: plays seeded games back to back with the planner's
+// placement heuristic, optionally looking ahead over the preview queue and
+// hold, and reports engine throughput.
+#include "GameCore.hpp"
+#include "Planner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    int      games     = 100;
+    int      threads   = 0;
+    uint32_t seed      = 1;
+    int      maxPieces = 100000;
+    int      rows      = 20;
+    int      cols      = 10;
+    int      depth     = 1;
+    int      beam      = 8;
+    double   budgetMs  = 0.0;
+    bool     hold      = true;
+    std::string weightsPath;
+};
+
+struct GameResult {
+    uint32_t seed   = 0;
+    long     pieces = 0;
+    long     lines  = 0;
+    long     score  = 0;
+    bool     capped = false;
+    uint64_t nodes  = 0;
+    double   searchSeconds = 0.0;
+};
+
+void printUsage() {
+    std::cout << "usage: tetris-sim [--games N] [--threads N] [--seed S] [--max-pieces N]\n"
+                 "                  [--rows N] [--cols N]\n"
+                 "                  [--depth N] [--beam N] [--budget-ms T] [--no-hold]\n"
+                 "                  [--weights FILE]\n"
+                 "  --depth 1 plays the one-ply heuristic; 2-4 runs the beam search, which may\n"
+                 "  also use hold unless --no-hold is given.\n"
+                 "  --budget-ms 0 (the default) disables the time limit, keeping runs repeatable.\n";
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto text = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            return argv[++i];
+        };
+        auto value = [&]() -> long { return std::stol(text()); };
+        if (arg == "--games")           opt.games     = int(value());
+        else if (arg == "--threads")    opt.threads   = int(value());
+        else if (arg == "--seed")       opt.seed      = uint32_t(value());
+        else if (arg == "--max-pieces") opt.maxPieces = int(value());
+        else if (arg == "--rows")       opt.rows      = int(value());
+        else if (arg == "--cols")       opt.cols      = int(value());
+        else if (arg == "--depth")      opt.depth     = int(value());
+        else if (arg == "--beam")       opt.beam      = int(value());
+        else if (arg == "--budget-ms")  opt.budgetMs  = std::stod(text());
+        else if (arg == "--no-hold")    opt.hold      = false;
+        else if (arg == "--weights")    opt.weightsPath = text();
+        else if (arg == "--help" || arg == "-h") { printUsage(); std::exit(0); }
+        else throw std::invalid_argument("unknown option " + arg);
+    }
+    if (opt.games <= 0 || opt.maxPieces <= 0)
+        throw std::invalid_argument("--games and --max-pieces must be positive");
+    if (opt.depth <= 0 || opt.beam <= 0)
+        throw std::invalid_argument("--depth and --beam must be positive");
+    if (opt.rows <= 0 || opt.cols <= 0 || opt.cols > Playfield::MaxCols)
+        throw std::invalid_argument("--rows must be positive and --cols in 1.." + std::to_string(Playfield::MaxCols));
+    if (opt.threads <= 0)
+        opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    opt.threads = std::min(opt.threads, opt.games);
+    return opt;
+}
+
+GameResult playGame(const Options& opt, uint32_t seed, Planner& planner) {
+    GameCore core(opt.rows, opt.cols, seed);
+    GameResult result;
+    result.seed = seed;
+
+    GameCore::Inputs clearing;
+    GameCore::Inputs hold;
+    hold.hold = true;
+    GameCore::Inputs drop;
+    drop.hardDrop = true;
+
+    Planner::LookaheadOptions lookahead;
+    lookahead.depth     = opt.depth;
+    lookahead.beamWidth = opt.beam;
+    lookahead.budgetMs  = opt.budgetMs;
+    lookahead.allowHold = opt.hold;
+
+    while (!core.isGameOver()) {
+        if (core.getBoard().isClearingLines) {
+            core.step(clearing, GameCore::LineClearDelayMs);
+            continue;
+        }
+        if (result.pieces >= opt.maxPieces) {
+            result.capped = true;
+            break;
+        }
+
+        if (opt.depth > 1) {
+            const Planner::Lookahead plan = planner.planLookahead(core.getBoard(), core.getCurrentShape(),
+                                                                  core.getNextPieces(), core.getHeldShape(),
+                                                                  core.canHoldPiece(), lookahead);
+            result.nodes         += plan.nodes;
+            result.searchSeconds += plan.seconds;
+            if (plan.hold) core.step(hold, 0);
+            drop.dropTarget = plan.lock;
+        } else {
+            drop.dropTarget = planner.planBestPlacement(core.getBoard(), core.getCurrentShape());
+        }
+        if (core.step(drop, 0).locked) ++result.pieces;
+    }
+
+    result.lines = core.getTotalLinesCleared();
+    result.score = core.getScore();
+    return result;
+}
+
+long percentile(const std::vector<long>& sorted, double p) {
+    const size_t idx = size_t(p * double(sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+void printDistribution(const char* name, std::vector<long> values) {
+    std::sort(values.begin(), values.end());
+    double mean = 0.0;
+    for (long v : values) mean += double(v);
+    mean /= double(values.size());
+
+    std::printf("%-14s min %-8ld p10 %-8ld p50 %-8ld p90 %-8ld max %-8ld mean %.1f\n",
+                name, values.front(), percentile(values, 0.10), percentile(values, 0.50),
+                percentile(values, 0.90), values.back(), mean);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const Options opt = parseOptions(argc, argv);
+        const PlacementWeights weights = opt.weightsPath.empty() ? PlacementWeights{}
+                                                                 : PlacementWeights::load(opt.weightsPath);
+
+        std::vector<GameResult> results(opt.games);
+        std::atomic<int> nextGame{0};
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+
+        // A throwing game must not unwind past joinable threads: the first
+        // error is kept, the remaining games are abandoned and it is rethrown
+        // once every thread has been joined.
+        auto worker = [&]() {
+            try {
+                Planner planner;
+                planner.setWeights(weights);
+                for (int g = nextGame++; g < opt.games; g = nextGame++) {
+                    results[g] = playGame(opt, opt.seed + uint32_t(g), planner);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) failure = std::current_exception();
+                nextGame = opt.games;
+            }
+        };
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        for (int t = 1; t < opt.threads; ++t) pool.emplace_back(worker);
+        worker();
+        for (auto& th : pool) th.join();
+        if (failure) std::rethrow_exception(failure);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        long     totalPieces = 0, totalLines = 0;
+        uint64_t totalNodes  = 0;
+        double   searchSeconds = 0.0;
+        int      capped = 0;
+        std::vector<long> pieces, lines, scores;
+        for (const auto& r : results) {
+            totalPieces += r.pieces;
+            totalLines  += r.lines;
+            capped      += r.capped ? 1 : 0;
+            totalNodes  += r.nodes;
+            searchSeconds += r.searchSeconds;
+            pieces.push_back(r.pieces);
+            lines.push_back(r.lines);
+            scores.push_back(r.score);
+        }
+
+        std::printf("games          %d (%d threads, seeds %u..%u, %d capped at %d pieces)\n",
+                    opt.games, opt.threads, opt.seed, opt.seed + uint32_t(opt.games - 1), capped, opt.maxPieces);
+        std::printf("elapsed        %.3f s\n", seconds);
+        std::printf("pieces         %ld (%.0f pieces/sec)\n", totalPieces, totalPieces / seconds);
+        std::printf("lines          %ld (%.0f lines/sec)\n", totalLines, totalLines / seconds);
+        if (totalNodes > 0) {
+            std::printf("search         depth %d, beam %d, %llu nodes (%.0f nodes/sec per thread)\n",
+                        opt.depth, opt.beam, static_cast<unsigned long long>(totalNodes),
+                        searchSeconds > 0.0 ? double(totalNodes) / searchSeconds : 0.0);
+        }
+        printDistribution("pieces/game", pieces);
+        printDistribution("lines/game", lines);
+        printDistribution("score/game", scores);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
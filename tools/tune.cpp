@@ -0,0 +1,324 @@
+// Weight tuner: cross-entropy search over the lock terms of the placement
+// heuristic. Every generation plays the same seeded headless games with
+// each sampled weight vector and the incumbent best, spread over all cores,
+// and refits the sampling distribution to the best candidates.
+#include "GameCore.hpp"
+#include "PlacementWeights.hpp"
+#include "Planner.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int Dims = PlacementWeights::LockCount;
+
+struct Options {
+    int         generations = 40;
+    int         population  = 32;
+    double      eliteFrac   = 0.25;
+    int         games       = 64;      // per candidate and generation
+    int         maxPieces   = 2000;
+    int         threads     = 0;
+    uint32_t    seed        = 1;
+    int         rows        = 20;
+    int         cols        = 10;
+    std::string startPath;
+    std::string checkpointPath = "tune.ckpt";
+    std::string outPath        = "best-weights.txt";
+    bool        resume         = false;
+};
+
+struct State {
+    int              generation  = 0;
+    double           bestFitness = -1.0;
+    PlacementWeights best;
+    double           mean[Dims]   = {};
+    double           sigma[Dims]  = {};
+    double           sigma0[Dims] = {};
+};
+
+void printUsage() {
+    std::cout << "usage: tetris-tune [--generations N] [--population N] [--elite F] [--games N]\n"
+                 "                   [--max-pieces N] [--threads N] [--seed S] [--rows N] [--cols N]\n"
+                 "                   [--start FILE] [--checkpoint FILE] [--out FILE] [--resume]\n"
+                 "  Fitness is the mean number of lines cleared per game, with games capped at\n"
+                 "  --max-pieces. Only the lock terms are searched; the rest come from --start.\n";
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto text = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            return argv[++i];
+        };
+        auto value = [&]() -> long { return std::stol(text()); };
+        if (arg == "--generations")     opt.generations = int(value());
+        else if (arg == "--population") opt.population  = int(value());
+        else if (arg == "--elite")      opt.eliteFrac   = std::stod(text());
+        else if (arg == "--games")      opt.games       = int(value());
+        else if (arg == "--max-pieces") opt.maxPieces   = int(value());
+        else if (arg == "--threads")    opt.threads     = int(value());
+        else if (arg == "--seed")       opt.seed        = uint32_t(value());
+        else if (arg == "--rows")       opt.rows        = int(value());
+        else if (arg == "--cols")       opt.cols        = int(value());
+        else if (arg == "--start")      opt.startPath      = text();
+        else if (arg == "--checkpoint") opt.checkpointPath = text();
+        else if (arg == "--out")        opt.outPath        = text();
+        else if (arg == "--resume")     opt.resume         = true;
+        else if (arg == "--help" || arg == "-h") { printUsage(); std::exit(0); }
+        else throw std::invalid_argument("unknown option " + arg);
+    }
+    if (opt.generations <= 0 || opt.games <= 0 || opt.maxPieces <= 0)
+        throw std::invalid_argument("--generations, --games and --max-pieces must be positive");
+    if (opt.population < 4)
+        throw std::invalid_argument("--population must be at least 4");
+    if (opt.eliteFrac <= 0.0 || opt.eliteFrac > 0.5)
+        throw std::invalid_argument("--elite must be in (0, 0.5]");
+    if (opt.rows <= 0 || opt.cols <= 0 || opt.cols > Playfield::MaxCols)
+        throw std::invalid_argument("--rows must be positive and --cols in 1.." + std::to_string(Playfield::MaxCols));
+    if (opt.threads <= 0)
+        opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    return opt;
+}
+
+long playGame(const Options& opt, uint32_t seed, Planner& planner, long& pieces) {
+    GameCore core(opt.rows, opt.cols, seed);
+    GameCore::Inputs clearing;
+    GameCore::Inputs drop;
+    drop.hardDrop = true;
+
+    pieces = 0;
+    while (!core.isGameOver() && pieces < opt.maxPieces) {
+        if (core.getBoard().isClearingLines) {
+            core.step(clearing, GameCore::LineClearDelayMs);
+            continue;
+        }
+        drop.dropTarget = planner.planBestPlacement(core.getBoard(), core.getCurrentShape());
+        if (core.step(drop, 0).locked) ++pieces;
+    }
+    return core.getTotalLinesCleared();
+}
+
+void writeCheckpoint(const std::string& path, const State& st) {
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp);
+        if (!out) throw std::runtime_error("Failed to write checkpoint: " + tmp);
+        out.precision(17);
+        out << "generation " << st.generation << '\n'
+            << "best_fitness " << st.bestFitness << '\n';
+        for (int d = 0; d < Dims; ++d) {
+            out << "dim " << PlacementWeights::name(d) << ' ' << st.mean[d] << ' ' << st.sigma[d] << ' '
+                << st.sigma0[d] << '\n';
+        }
+        for (int i = 0; i < PlacementWeights::Count; ++i)
+            out << "best " << PlacementWeights::name(i) << ' ' << st.best[i] << '\n';
+        if (!out) throw std::runtime_error("Failed to write checkpoint: " + tmp);
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec)
+        throw std::runtime_error("Failed to replace checkpoint: " + path);
+}
+
+State readCheckpoint(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Failed to open checkpoint: " + path);
+
+    auto indexOf = [](const std::string& name) {
+        for (int i = 0; i < PlacementWeights::Count; ++i)
+            if (name == PlacementWeights::name(i)) return i;
+        throw std::runtime_error("unknown weight in checkpoint: " + name);
+    };
+
+    State st;
+    bool haveGeneration = false;
+    bool haveDim[Dims] = {};
+    bool haveBest[PlacementWeights::Count] = {};
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string tag, name;
+        if (!(fields >> tag)) continue;
+        if (tag == "generation") {
+            fields >> st.generation;
+            haveGeneration = true;
+        }
+        else if (tag == "best_fitness") fields >> st.bestFitness;
+        else if (tag == "dim") {
+            fields >> name;
+            const int d = indexOf(name);
+            if (d >= Dims) throw std::runtime_error("not a tuned weight: " + name);
+            fields >> st.mean[d] >> st.sigma[d] >> st.sigma0[d];
+            haveDim[d] = true;
+        } else if (tag == "best") {
+            fields >> name;
+            const int i = indexOf(name);
+            fields >> st.best[i];
+            haveBest[i] = true;
+        } else {
+            throw std::runtime_error("bad checkpoint line: " + line);
+        }
+        if (fields.fail()) throw std::runtime_error("bad checkpoint line: " + line);
+    }
+
+    // A partial checkpoint would resume with zero means and spreads and
+    // quietly collapse the search.
+    if (!haveGeneration) throw std::runtime_error("checkpoint has no generation: " + path);
+    for (int d = 0; d < Dims; ++d)
+        if (!haveDim[d])
+            throw std::runtime_error("checkpoint is missing dim " + std::string(PlacementWeights::name(d)) + ": " + path);
+    for (int i = 0; i < PlacementWeights::Count; ++i)
+        if (!haveBest[i])
+            throw std::runtime_error("checkpoint is missing best " + std::string(PlacementWeights::name(i)) + ": " + path);
+    return st;
+}
+
+State initialState(const Options& opt) {
+    State st;
+    st.best = opt.startPath.empty() ? PlacementWeights{} : PlacementWeights::load(opt.startPath);
+    for (int d = 0; d < Dims; ++d) {
+        st.mean[d]   = st.best[d];
+        st.sigma0[d] = std::max(4.0, 0.5 * std::abs(double(st.best[d])));
+        st.sigma[d]  = st.sigma0[d];
+    }
+    return st;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        const Options opt = parseOptions(argc, argv);
+        State st = opt.resume ? readCheckpoint(opt.checkpointPath) : initialState(opt);
+        const int eliteCount = std::max(2, int(opt.population * opt.eliteFrac));
+
+        // The last slot holds the incumbent best, re-scored every generation
+        // so that it is only ever compared on the same seeds as the samples.
+        const int incumbent = opt.population;
+        std::vector<PlacementWeights> candidates(opt.population + 1, st.best);
+        std::vector<long>             lines(size_t(opt.population + 1) * opt.games);
+        std::vector<double>           fitness(opt.population + 1);
+        std::vector<int>              order(opt.population);
+
+        std::printf("tuning %d weights: population %d, elite %d, %d games x %d pieces, %d threads\n",
+                    Dims, opt.population, eliteCount, opt.games, opt.maxPieces, opt.threads);
+
+        while (st.generation < opt.generations) {
+            // Sampling depends only on the seed and the generation, so a
+            // resumed run continues exactly where the checkpoint left off.
+            std::mt19937_64 rng((uint64_t(opt.seed) << 32) ^ uint64_t(st.generation) * 0x9E3779B97F4A7C15ull);
+            std::normal_distribution<double> normal;
+            for (int c = 0; c < opt.population; ++c) {
+                candidates[c] = st.best;
+                for (int d = 0; d < Dims; ++d)
+                    candidates[c][d] = int(std::lround(st.mean[d] + st.sigma[d] * normal(rng)));
+            }
+
+            candidates[incumbent] = st.best;
+
+            // Every candidate plays the same seeds, which keeps the ranking
+            // about the weights rather than the piece sequences.
+            const uint32_t gameSeed = opt.seed + uint32_t(st.generation) * uint32_t(opt.games);
+            const int      jobs     = (opt.population + 1) * opt.games;
+            std::atomic<int>  nextJob{0};
+            std::atomic<long> pieceCount{0};
+            std::exception_ptr failure;
+            std::mutex failureMutex;
+            auto worker = [&]() {
+                try {
+                    Planner planner;
+                    for (int j = nextJob++; j < jobs; j = nextJob++) {
+                        const int c = j / opt.games, g = j % opt.games;
+                        planner.setWeights(candidates[c]);
+                        long pieces = 0;
+                        lines[j] = playGame(opt, gameSeed + uint32_t(g), planner, pieces);
+                        pieceCount += pieces;
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure) failure = std::current_exception();
+                    nextJob = jobs;
+                }
+            };
+
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> pool;
+            for (int t = 1; t < opt.threads; ++t) pool.emplace_back(worker);
+            worker();
+            for (auto& th : pool) th.join();
+            if (failure) std::rethrow_exception(failure);
+            const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            for (int c = 0; c <= opt.population; ++c) {
+                long sum = 0;
+                for (int g = 0; g < opt.games; ++g) sum += lines[size_t(c) * opt.games + g];
+                fitness[c] = double(sum) / opt.games;
+                if (c < opt.population) order[c] = c;
+            }
+            std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return fitness[a] > fitness[b]; });
+
+            // Refit to the elite. The extra noise shrinks to zero over the
+            // run and stops the distribution collapsing early.
+            const double noise = 0.1 * std::max(0.0, 1.0 - double(st.generation) / opt.generations);
+            for (int d = 0; d < Dims; ++d) {
+                double mean = 0.0, var = 0.0;
+                for (int e = 0; e < eliteCount; ++e) mean += candidates[order[e]][d];
+                mean /= eliteCount;
+                for (int e = 0; e < eliteCount; ++e) {
+                    const double diff = candidates[order[e]][d] - mean;
+                    var += diff * diff;
+                }
+                st.mean[d]  = mean;
+                st.sigma[d] = std::sqrt(var / eliteCount) + noise * st.sigma0[d];
+            }
+
+            double meanFitness = 0.0;
+            for (int c = 0; c < opt.population; ++c) meanFitness += fitness[c];
+            meanFitness /= opt.population;
+
+            // Seeds move on every generation, so the best fitness is the
+            // incumbent's score on this generation's games, not a record.
+            const PlacementWeights& top = candidates[order[0]];
+            if (fitness[order[0]] > fitness[incumbent]) {
+                st.bestFitness = fitness[order[0]];
+                st.best        = top;
+            } else {
+                st.bestFitness = fitness[incumbent];
+            }
+            st.best.save(opt.outPath);
+            const int generation = st.generation++;
+            writeCheckpoint(opt.checkpointPath, st);
+
+            std::printf("gen %-4d top %-9.1f mean %-9.1f best %-9.1f %.0f pieces/sec  ", generation,
+                        fitness[order[0]], meanFitness, st.bestFitness, pieceCount.load() / seconds);
+            for (int d = 0; d < Dims; ++d) std::printf(" %s=%d", PlacementWeights::name(d), top[d]);
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+        std::printf("best fitness %.1f written to %s\n", st.bestFitness, opt.outPath.c_str());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}